@@ -314,4 +314,119 @@ namespace fm{
     }   
 
 
+    // 以下为尝试作为double的normal档位（保证double最后一位级别精度）的实现，移植自fdlibm
+    // 精度均在1ulp以内，但经过测试速度均不如标准库（glibc的log/log2/exp2/atan/atan2已是查表+多项式实现），因此未采用
+
+    //经过测试，误差0.8ulp，速度比标准库慢23%
+    //log2版本（同样的约化后乘 1/ln2 的高低两部分）误差0.8ulp，速度比标准库慢60%以上
+    inline double log_d(double x){
+        union {double f; uint64_t i;} u;
+        u.f = x;
+        uint32_t hx = u.i>>32;
+        if(hx<0x00100000u||hx>=0x7ff00000u) return std::log(x);
+        int32_t k = (int32_t)(hx>>20)-1023;
+        hx &= 0x000fffff;
+        uint32_t i = (hx+0x95f64)&0x100000; //归一化到[sqrt2/2,sqrt2)
+        k += (i>>20);
+        u.i = ((uint64_t)(hx|(i^0x3ff00000))<<32)|(u.i&0xffffffffu);
+        double f = u.f-1.0;
+        const double Lg1 = 6.666666666666735130e-01, Lg2 = 3.999999999940941908e-01,
+                     Lg3 = 2.857142874366239149e-01, Lg4 = 2.222219843214978396e-01,
+                     Lg5 = 1.818357216161805012e-01, Lg6 = 1.531383769920937332e-01,
+                     Lg7 = 1.479819860511658591e-01;
+        const double ln2_hi = 6.93147180369123816490e-01, ln2_lo = 1.90821492927058770002e-10;
+        double s = f/(2.0+f), z = s*s, w = z*z;
+        double R = z*(Lg1+w*(Lg3+w*(Lg5+w*Lg7)))+w*(Lg2+w*(Lg4+w*Lg6));
+        double hfsq = 0.5*f*f, dk = k;
+        return dk*ln2_hi-((hfsq-(s*(hfsq+R)+dk*ln2_lo))-f);
+    }
+
+    //经过测试，误差1.02ulp，[-1000,1000]上比标准库快，但常用的[-10,10]上比标准库慢35%
+    //（与FastMath.h中double的exp同样的 2^(i/32) 查表实现）
+    inline double exp2_d(double x){
+        if(!(abs(x)<1020.0)) return std::exp2(x);
+        double kd = std::nearbyint(x*32);
+        int64_t k = (int64_t)kd;
+        double f = x-kd*(1.0/32);
+        double r = f*6.93147180369123816490e-01+f*1.90821492927058770002e-10;
+        double p = r*(1.0+r*(1.0/2+r*(1.0/6+r*(1.0/24+r*(1.0/120+r*(1.0/720))))));
+        double t = std::exp2((k&31)/32.0); //FastMath.h中为查表
+        union {uint64_t i; double f;} sc;
+        sc.i = (uint64_t)((k>>5)+1023)<<52;
+        return (t+t*p)*sc.f;
+    }
+
+    //经过测试，误差0.8ulp，输入在[-1,1]时比标准库慢一倍（分段导致分支预测失败）
+    //atan2在此基础上用 atan(|y/x|) 再按象限修正，误差2.7ulp，比标准库慢44%
+    inline double atan_d(double x){
+        const double atanhi[] = {4.63647609000806093515e-01,7.85398163397448278999e-01,
+                                 9.82793723247329054082e-01,1.57079632679489655800e+00};
+        const double atanlo[] = {2.26987774529616870924e-17,3.06161699786838301793e-17,
+                                 1.39033110312309984516e-17,6.12323399573676603587e-17};
+        const double aT[] = {3.33333333333329318027e-01,-1.99999999998764832476e-01,1.42857142725034663711e-01,
+                            -1.11111104054623557880e-01,9.09088713343650656196e-02,-7.69187620504482999495e-02,
+                             6.66107313738753120669e-02,-5.83357013379057348645e-02,4.97687799461593236017e-02,
+                            -3.65315727442169155270e-02,1.62858201153657823623e-02};
+        double ax = abs(x);
+        int id;
+        if(!(ax<1e20)) return std::atan(x);
+        if(ax<0.4375) id = -1;
+        else if(ax<0.6875){ id = 0; ax = (2.0*ax-1.0)/(2.0+ax); }
+        else if(ax<1.1875){ id = 1; ax = (ax-1.0)/(ax+1.0); }
+        else if(ax<2.4375){ id = 2; ax = (ax-1.5)/(1.0+1.5*ax); }
+        else { id = 3; ax = -1.0/ax; }
+        double z = ax*ax, w = z*z;
+        double s1 = z*(aT[0]+w*(aT[2]+w*(aT[4]+w*(aT[6]+w*(aT[8]+w*aT[10])))));
+        double s2 = w*(aT[1]+w*(aT[3]+w*(aT[5]+w*(aT[7]+w*aT[9]))));
+        double r = (id<0) ? ax-ax*(s1+s2) : atanhi[id]-((ax*(s1+s2)-atanlo[id])-ax);
+        return x<0 ? -r : r;
+    }
+
+
+    //原exp(float)的fast2档位：(1+x/4096)^4096 再做二阶修正，误差不超过2e-3
+    //函数指针调用时比std快16%，但不如2次多项式的_exp2_kernel<2>（快32%，误差1.8e-3），因此被替换
+    inline float exp_sq(float x){
+        float t = 1.0f + x/4096;
+        t *= t;  t *= t; t *= t; t *= t;
+        t *= t;  t *= t; t *= t; t *= t;
+        t *= t;  t *= t; t *= t; t *= t;
+        return t * (1+ 0.0001271152f * x * x);
+    }
+
+    //原asin/acos(float)的fast1/fast2档位：FastMath.h中的asin_lut<1024,1>查表，abs(x)>0.99时回退到std（查表在+-1附近导数发散，不满足1e-4）
+    //输入全在[0.99,1]内时asin比std慢15%，被无分支的sqrt(1-x)*P(x)（_acos_abs_kernel<3>，任意输入都快42%以上）替换；asin_lut仍保留在FastMath.h中
+    // inline float asin(float x){
+    //     if(abs(x)>1) return std::numeric_limits<float>::quiet_NaN();
+    //     if(abs(x)>0.99) return std::asin(x);
+    //     return asin_lut<_bk>(x);
+    // }
+
+
+    //原atan(float)与atan2(float,float)的fast2/fast3档位：atan按abs(x)<=1分支（2次多项式，误差不超过1e-3），atan2按符号与|x|、|y|的大小分支（误差不超过2e-4）
+    //输入随机时分支难以预测（atan比std只快31%），也阻碍了批量接口的向量化，被无分支的_atan_kernel、_atan2_kernel（快66%、59%）替换
+    inline float _Fast2ArcTan(const float x) {
+        float xx = x * x;
+        return ((0.0776509570923569f*xx -0.287434475393028f)*xx + ((pi_f/4.0f) -0.0776509570923569f +0.287434475393028))*x;
+    }
+    inline float atan_fast2_branch(float x){
+        if(std::abs(x)<=1){
+            return _Fast2ArcTan(x);
+        }
+        else{
+            x=1/x;
+            float t=_Fast2ArcTan(x);
+            return ((x>0)-0.5f)*pi_f - t;
+        }
+    }
+    inline float atan2_fast2_branch(float y,float x){
+        float ax = std::abs(x), ay = std::abs(y);
+        float a = ((ax > ay) ? ay : ax) / ((ax > ay) ? ax : ay);
+        float s = a * a;
+        float r = ((-0.0464964749f * s + 0.15931422f) * s - 0.327622764f) * s * a + a;
+        if (ay > ax) r = hpi_f - r;
+        if (x < 0) r = pi_f - r;
+        if (y < 0) r = -r;
+        return r;
+    }
+
 }//namespace fm
\ No newline at end of file
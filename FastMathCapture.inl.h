@@ -0,0 +1,183 @@
+// 仅用于FastMath.h中#include，提供参数记录（capture）：定义宏FM_CAPTURE=1时，fm::的各函数（标量与批量接口）
+// 抽样记录调用参数，每个函数每种类型一个二进制文件，供FastMathBench --replay按实际的输入分布比较各档位
+// 未定义FM_CAPTURE（默认0）时FM_CAPTURE_CALL/FM_CAPTURE_BATCH为空，不影响任何函数
+//
+// 环境变量：FM_CAPTURE_DIR 输出目录（默认当前目录，须已存在）
+//          FM_CAPTURE_RATE 每个线程每个函数每RATE次调用（批量接口为每RATE个元素）记录一次（默认64）
+//          FM_CAPTURE_MAX 每个文件最多记录的调用数（默认2^22），达到后不再记录
+// 文件：<dir>/<函数名>.f32.fmcap 与 .f64.fmcap，文件头为8字节"FMCAP1\0\0"、uint32参数个数、uint32每个参数的字节数，
+//      之后为逐条记录（双参数函数如pow(x,y)依次为x、y），本机字节序；每次运行覆盖上一次的文件
+// 记录先写入每个线程自己的缓冲区（无锁），缓冲区满或线程退出时才加锁写入文件；
+// 函数内部再调用fm::函数（如double版本转为float计算）时不重复记录
+#pragma once
+
+#ifndef FM_CAPTURE
+    #define FM_CAPTURE 0
+#endif
+
+#if FM_CAPTURE
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace fm{
+namespace capture{
+
+    #define FM_CAPTURE_FUNCS(X) X(sin) X(cos) X(tan) X(sincos) X(asin) X(acos) X(atan) X(atan2) \
+        X(exp) X(exp2) X(expm1) X(log) X(log2) X(log10) X(log1p) X(cbrt) X(rsqrt) X(pow) X(hypot) \
+        X(tanh) X(sinh) X(cosh) X(erf) X(sigmoid) X(softplus)
+
+    enum func_id{
+        #define FM_CAPTURE_ID(f) cap_##f,
+        FM_CAPTURE_FUNCS(FM_CAPTURE_ID)
+        #undef FM_CAPTURE_ID
+        cap_count
+    };
+
+    inline const char* func_name(int id){
+        static const char* names[] = {
+            #define FM_CAPTURE_NAME(f) #f,
+            FM_CAPTURE_FUNCS(FM_CAPTURE_NAME)
+            #undef FM_CAPTURE_NAME
+        };
+        return names[id];
+    }
+
+    struct config{
+        std::string dir = ".";
+        uint32_t rate = 64;
+        uint64_t max_records = (uint64_t)1<<22;
+    };
+    inline const config& cfg(){
+        static const config c = [](){
+            config r;
+            if(const char* s = std::getenv("FM_CAPTURE_DIR")) r.dir = s;
+            if(const char* s = std::getenv("FM_CAPTURE_RATE")){ long v = std::strtol(s,nullptr,10); r.rate = v>0 ? (uint32_t)v : 1; }
+            if(const char* s = std::getenv("FM_CAPTURE_MAX")) r.max_records = std::strtoull(s,nullptr,10);
+            return r;
+        }();
+        return c;
+    }
+
+    // 每个(函数,类型)一个文件，首次写入时创建（覆盖旧文件）并写文件头；进程退出时关闭
+    // 线程的thread_local缓冲区在静态对象析构前写完，主线程退出时的记录不会丢失
+    class writer{
+    public:
+        void write(int slot,const void* data,size_t bytes,uint32_t arity,uint32_t size){
+            std::lock_guard<std::mutex> lock(m);
+            if(!files[slot]){
+                if(failed[slot]) return;
+                std::string path = cfg().dir+"/"+func_name(slot/2)+(slot%2 ? ".f64.fmcap" : ".f32.fmcap");
+                files[slot] = std::fopen(path.c_str(),"wb");
+                if(!files[slot]){ failed[slot] = true; return; }
+                std::fwrite("FMCAP1\0\0",1,8,files[slot]);
+                std::fwrite(&arity,4,1,files[slot]);
+                std::fwrite(&size,4,1,files[slot]);
+            }
+            std::fwrite(data,1,bytes,files[slot]);
+            std::fflush(files[slot]); //每个线程缓冲区满或退出时才写入，次数很少；进程结束前文件即完整
+            records[slot].fetch_add(bytes/((uint64_t)arity*size),std::memory_order_relaxed);
+        }
+        std::atomic<uint64_t> records[cap_count*2] = {}; //已写入的记录数，写入时才累加，FM_CAPTURE_MAX可能被略微超过
+        ~writer(){
+            for(FILE* f:files) if(f) std::fclose(f);
+        }
+    private:
+        std::mutex m;
+        FILE* files[cap_count*2] = {};
+        bool failed[cap_count*2] = {};
+    };
+    inline writer& out(){
+        static writer w;
+        return w;
+    }
+
+    struct thread_buffers{
+        static const size_t flush_bytes = 1<<16;
+        std::vector<char> buf[cap_count*2];
+        uint32_t arity[cap_count*2] = {};
+        uint32_t tick[cap_count*2] = {};
+        int depth = 0;
+        void flush(int slot){
+            std::vector<char>& b = buf[slot];
+            if(b.empty()) return;
+            out().write(slot,b.data(),b.size(),arity[slot],slot%2 ? 8 : 4);
+            b.clear();
+        }
+        ~thread_buffers(){
+            for(int s=0;s<cap_count*2;++s) flush(s);
+        }
+    };
+    inline thread_local thread_buffers tls;
+
+    // 只有最外层的fm::调用记录参数
+    struct scope{
+        bool outer;
+        scope() : outer(tls.depth++==0) {}
+        ~scope(){ --tls.depth; }
+    };
+
+    //追加一条记录，已达到FM_CAPTURE_MAX时丢弃；共享的计数只读不写，记录时线程之间没有竞争
+    template<class T>
+    inline void append(int slot,const T* v,uint32_t arity){
+        thread_buffers& t = tls;
+        if(out().records[slot].load(std::memory_order_relaxed)>=cfg().max_records) return;
+        t.arity[slot] = arity;
+        std::vector<char>& b = t.buf[slot];
+        b.insert(b.end(),(const char*)v,(const char*)(v+arity));
+        if(b.size()>=thread_buffers::flush_bytes) t.flush(slot);
+    }
+
+    //非float的参数（double、整数）都按double记录
+    template<class T>
+    using rec_t = typename std::conditional<std::is_same<T,float>::value,float,double>::type;
+
+    template<class T>
+    inline void record(func_id id,T x){
+        int slot = id*2+(std::is_same<T,float>::value ? 0 : 1);
+        if(tls.tick[slot]++%cfg().rate) return;
+        rec_t<T> v = (rec_t<T>)x;
+        append(slot,&v,1);
+    }
+    template<class T,class U>
+    inline void record(func_id id,T x,U y){
+        typedef typename std::conditional<std::is_same<T,float>::value && std::is_same<U,float>::value,float,double>::type R;
+        int slot = id*2+(sizeof(R)==4 ? 0 : 1);
+        if(tls.tick[slot]++%cfg().rate) return;
+        R v[2] = {(R)x,(R)y};
+        append(slot,v,2);
+    }
+
+    //批量接口：每rate个元素记录一个，y为空时为单参数函数，否则y[i]（或yc，y为空且binary时）为第二个参数
+    template<class T>
+    inline void record_batch(func_id id,const T* x,const T* y,T yc,bool binary,size_t n){
+        int slot = id*2+(sizeof(T)==4 ? 0 : 1);
+        uint32_t rate = cfg().rate, tk = tls.tick[slot];
+        for(size_t i=(rate-tk%rate)%rate;i<n;i+=rate){
+            T v[2] = {x[i],y ? y[i] : yc};
+            append(slot,v,binary ? 2 : 1);
+        }
+        tls.tick[slot] = tk+(uint32_t)n;
+    }
+    template<class T>
+    inline void record_batch(func_id id,const T* x,size_t n){ record_batch(id,x,(const T*)nullptr,(T)0,false,n); }
+    template<class T>
+    inline void record_batch(func_id id,const T* x,const T* y,size_t n){ record_batch(id,x,y,(T)0,true,n); }
+    template<class T>
+    inline void record_batch(func_id id,const T* x,T y,size_t n){ record_batch(id,x,(const T*)nullptr,y,true,n); }
+
+}//namespace capture
+}//namespace fm
+
+    #define FM_CAPTURE_CALL(func,...) fm::capture::scope _fm_capture_scope; if(_fm_capture_scope.outer) fm::capture::record(fm::capture::cap_##func,__VA_ARGS__)
+    #define FM_CAPTURE_BATCH(func,...) fm::capture::scope _fm_capture_scope; if(_fm_capture_scope.outer) fm::capture::record_batch(fm::capture::cap_##func,__VA_ARGS__)
+#else
+    #define FM_CAPTURE_CALL(func,...)
+    #define FM_CAPTURE_BATCH(func,...)
+#endif
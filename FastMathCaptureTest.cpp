@@ -0,0 +1,69 @@
+// FM_CAPTURE=1时的参数记录：在工作线程中调用标量与批量接口（线程退出时写入文件），检查文件头、记录数与内容
+// double版本转为float计算时只记录一次（在.f64文件中）
+#define FM_CAPTURE 1
+#include "FastMath.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct trace{
+    uint32_t arity = 0, size = 0;
+    std::vector<char> data;
+    size_t records() const { return arity ? data.size()/(arity*size) : 0; }
+};
+
+static bool load(const std::string& path,trace& t){
+    FILE* f = fopen(path.c_str(),"rb");
+    if(!f) return false;
+    char magic[8];
+    bool ok = fread(magic,1,8,f)==8 && memcmp(magic,"FMCAP1\0\0",8)==0 && fread(&t.arity,4,1,f)==1 && fread(&t.size,4,1,f)==1;
+    char buf[4096];
+    for(size_t r;ok && (r=fread(buf,1,sizeof(buf),f))>0;) t.data.insert(t.data.end(),buf,buf+r);
+    fclose(f);
+    return ok;
+}
+
+int main(){
+    setenv("FM_CAPTURE_RATE","1",1);
+    setenv("FM_CAPTURE_DIR",".",1);
+    const int threads = 2, calls = 1000, batch = 100;
+    std::vector<std::thread> th;
+    for(int t=0;t<threads;++t){
+        th.emplace_back([](){
+            volatile float s = 0;
+            for(int i=0;i<calls;++i){
+                s = s + fm::sin((float)i,fm::ESpeedFast1);
+                s = s + (float)fm::sin((double)i,fm::ESpeedFast2); //double转float计算，只记录为f64
+                s = s + fm::pow(1.5f,(float)i,fm::ESpeedFast1);
+            }
+            std::vector<float> in(batch,0.25f), out(batch);
+            fm::sin(in.data(),out.data(),batch,fm::ESpeedFast1);
+        });
+    }
+    for(auto& t:th) t.join();
+
+    int failed = 0;
+    auto check = [&](const char* file,uint32_t arity,uint32_t size,size_t records){
+        trace t;
+        bool ok = load(file,t) && t.arity==arity && t.size==size && t.records()==records;
+        printf("  %-16s %zu records %s\n",file,t.records(),ok?"ok":"FAILED");
+        if(!ok) ++failed;
+        return t;
+    };
+    trace sf = check("sin.f32.fmcap",1,4,threads*(calls+batch));
+    check("sin.f64.fmcap",1,8,threads*calls);
+    trace pf = check("pow.f32.fmcap",2,4,threads*calls);
+    //每个线程退出时一次写入，文件的最后一条为批量接口记录的数组元素；pow记录(x,y)
+    float last, p[2];
+    memcpy(&last,sf.data.data()+sf.data.size()-4,4);
+    memcpy(p,pf.data.data(),8);
+    if(last!=0.25f || p[0]!=1.5f){ printf("  content FAILED\n"); ++failed; }
+    for(const char* f:{"sin.f32.fmcap","sin.f64.fmcap","pow.f32.fmcap"}) remove(f);
+    printf(failed?"%d check(s) FAILED\n":"all passed\n",failed);
+    return failed?1:0;
+}
@@ -0,0 +1,227 @@
+// 对所有2^32个float输入穷举各一元函数各档位的误差，参考值为double下的std实现
+// 报告最大ulp误差、最大绝对误差、最大相对误差、最大min(绝对误差,相对误差)（即ESpeed各档位的承诺）及各自最差输入
+// 结果打印为表格并写入csv（默认certify.csv）；所有线程动态分块扫描，耗时与核数成反比
+// 用法：FastMathCertify [-o out.csv] [-t 线程数] [-s 步长] [-n] [-T std,normal,fast1,fast2,fast3] [函数名...]
+//   -s N 只扫描每第N个位模式（快速检查用，默认1即穷举）；-n 跳过非规格化输入（开启FTZ/DAZ时）；不给函数名时扫描全部
+// 跳过的输入：x为nan/inf、参考值为nan（定义域外）、参考值超出float范围；这些情况的特殊处理由FastMathSweepTest和SimdDispatchTest检查
+// normal的上界为max(1ulp,std的最大ulp误差)，即不差于std；fast按ESpeed注释中min(绝对误差,相对误差)的上界
+// 参考值有限而结果为nan/inf时计入nonfinite，误差记为inf
+// 函数注释中注明不保证结果的输入（见各函数的exempt）计入exempt，不计入误差与判定
+#include "FastMath.h"
+
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+static const int TIER_N = 5;
+static const char* tier_names[TIER_N] = {"std","normal","fast1","fast2","fast3"};
+//fast按min(绝对误差,相对误差)检验，normal见tier_bound，std不检验
+static const double tier_bounds[TIER_N] = {0,1.0,1e-4,2e-3,4e-2};
+
+struct cert_func{
+    const char* name;
+    double (*ref)(double);
+    float (*f[TIER_N])(float);
+    bool (*exempt)(float x,double ref,int tier);
+};
+
+//tan的快速档位：奇异点附近（|tan(x)|>1e4，即x距奇异点不到1e-4）不保证误差（见fm::tan的注释）
+static bool tan_exempt(float,double ref,int k){
+    return k>=fm::ESpeedFast1 && std::abs(ref)>1e4;
+}
+//log log2 log10 rsqrt的快速档位对非规格化输入不保证结果（见各函数的注释）
+static bool subnormal_exempt(float x,double,int k){
+    return k>=fm::ESpeedFast1 && x!=0 && std::abs(x)<FLT_MIN;
+}
+
+#define CERT_TIER(func,s) [](float x){ return fm::func(x,fm::s); }
+#define CERT_FUNC_EX(func,refexpr,exempt) {#func,[](double d){ return (double)(refexpr); },{CERT_TIER(func,ESpeedStd),CERT_TIER(func,ESpeedNormal),CERT_TIER(func,ESpeedFast1),CERT_TIER(func,ESpeedFast2),CERT_TIER(func,ESpeedFast3)},exempt}
+#define CERT_FUNC(func,refexpr) CERT_FUNC_EX(func,refexpr,nullptr)
+
+static const cert_func funcs[] = {
+    CERT_FUNC(sin,std::sin(d)),
+    CERT_FUNC(cos,std::cos(d)),
+    CERT_FUNC_EX(tan,std::tan(d),tan_exempt),
+    CERT_FUNC(asin,std::asin(d)),
+    CERT_FUNC(acos,std::acos(d)),
+    CERT_FUNC(atan,std::atan(d)),
+    CERT_FUNC(exp,std::exp(d)),
+    CERT_FUNC(exp2,std::exp2(d)),
+    CERT_FUNC(expm1,std::expm1(d)),
+    CERT_FUNC_EX(log,std::log(d),subnormal_exempt),
+    CERT_FUNC_EX(log2,std::log2(d),subnormal_exempt),
+    CERT_FUNC_EX(log10,std::log10(d),subnormal_exempt),
+    CERT_FUNC(log1p,std::log1p(d)),
+    CERT_FUNC(cbrt,std::cbrt(d)),
+    CERT_FUNC_EX(rsqrt,1/std::sqrt(d),subnormal_exempt),
+    CERT_FUNC(tanh,std::tanh(d)),
+    CERT_FUNC(sinh,std::sinh(d)),
+    CERT_FUNC(cosh,std::cosh(d)),
+    CERT_FUNC(erf,std::erf(d)),
+    CERT_FUNC(sigmoid,1/(1+std::exp(-d))),
+    CERT_FUNC(softplus,d>0 ? d+std::log1p(std::exp(-d)) : std::log1p(std::exp(d))),
+};
+
+//一种误差度量的最大值及取到它的输入
+struct cert_max{
+    double v = 0;
+    float x = 0;
+    void put(double e,float in){ if(!(e<=v)){ v=e; x=in; } }
+    void merge(const cert_max& o){ if(!(o.v<=v)) *this=o; }
+};
+
+struct cert_result{
+    cert_max ulp,abs,rel,err;
+    uint64_t nonfinite = 0, exempt = 0;
+    void merge(const cert_result& o){ ulp.merge(o.ulp); abs.merge(o.abs); rel.merge(o.rel); err.merge(o.err); nonfinite+=o.nonfinite; exempt+=o.exempt; }
+};
+
+//float结果y相对参考值ref的误差，以ref所在区间的float ulp为单位
+static double ulp_err(float y,double ref){
+    if(ref==0) return y==0 ? 0 : INFINITY;
+    int e;
+    std::frexp(ref,&e);
+    double ulp = std::ldexp(1.0,std::max(e-24,-149));
+    return std::abs((double)y-ref)/ulp;
+}
+
+struct cert_options{
+    const char* out = "certify.csv";
+    unsigned threads = std::max(1u,std::thread::hardware_concurrency());
+    uint64_t step = 1;
+    bool no_subnormal = false;
+    bool tiers[TIER_N] = {true,true,true,true,true};
+    std::vector<std::string> names;
+};
+
+//扫描一个函数选中的所有档位，参考值每个输入只算一次；返回被跳过的输入数
+static uint64_t certify(const cert_func& fn,const cert_options& opt,cert_result (&res)[TIER_N]){
+    const uint64_t n = ((uint64_t)1<<32)/opt.step, chunk = 1<<16;
+    std::atomic<uint64_t> next(0), skipped(0);
+    std::vector<cert_result> part((size_t)opt.threads*TIER_N);
+    std::vector<std::thread> th;
+    for(unsigned t=0;t<opt.threads;++t){
+        th.emplace_back([&,t](){
+            cert_result* r = &part[(size_t)t*TIER_N];
+            uint64_t skip = 0;
+            for(uint64_t b;(b=next.fetch_add(chunk))<n;){
+                uint64_t e = std::min(n,b+chunk);
+                for(uint64_t j=b;j<e;++j){
+                    uint32_t i = (uint32_t)(j*opt.step);
+                    float x;
+                    std::memcpy(&x,&i,4);
+                    bool in = std::isfinite(x) && !(opt.no_subnormal && x!=0 && std::abs(x)<FLT_MIN);
+                    double ref = in ? fn.ref(x) : NAN;
+                    if(!(std::abs(ref)<=FLT_MAX)){ ++skip; continue; }
+                    for(int k=0;k<TIER_N;++k){
+                        if(!opt.tiers[k]) continue;
+                        if(fn.exempt && fn.exempt(x,ref,k)){ ++r[k].exempt; continue; }
+                        float y = fn.f[k](x);
+                        double a = INFINITY, rl = INFINITY, u = INFINITY;
+                        if(std::isfinite(y)){
+                            a = std::abs((double)y-ref);
+                            rl = ref!=0 ? a/std::abs(ref) : (y==0 ? 0 : INFINITY);
+                            u = ulp_err(y,ref);
+                        }
+                        else ++r[k].nonfinite;
+                        r[k].ulp.put(u,x);
+                        r[k].abs.put(a,x);
+                        r[k].rel.put(rl,x);
+                        r[k].err.put(std::min(a,rl),x);
+                    }
+                }
+            }
+            skipped += skip;
+        });
+    }
+    for(auto& t:th) t.join();
+    for(int k=0;k<TIER_N;++k){
+        res[k] = cert_result();
+        for(unsigned t=0;t<opt.threads;++t) res[k].merge(part[(size_t)t*TIER_N+k]);
+    }
+    return skipped;
+}
+
+static double tier_bound(int k,const cert_result (&res)[TIER_N]){
+    if(k==fm::ESpeedNormal) return std::max(tier_bounds[k],res[fm::ESpeedStd].ulp.v);
+    return tier_bounds[k];
+}
+
+static bool tier_pass(int k,const cert_result (&res)[TIER_N]){
+    if(k==fm::ESpeedStd) return true;
+    if(k==fm::ESpeedNormal) return res[k].ulp.v<=tier_bound(k,res);
+    return res[k].err.v<=tier_bound(k,res);
+}
+
+static bool parse_args(int argc,char** argv,cert_options& opt){
+    for(int i=1;i<argc;++i){
+        std::string a = argv[i];
+        if((a=="-o"||a=="-t"||a=="-s"||a=="-T") && i+1>=argc) return false;
+        if(a=="-o") opt.out = argv[++i];
+        else if(a=="-t") opt.threads = std::max(1,atoi(argv[++i]));
+        else if(a=="-s") opt.step = std::max(1ll,atoll(argv[++i]));
+        else if(a=="-n") opt.no_subnormal = true;
+        else if(a=="-T"){
+            std::string list = std::string(",")+argv[++i]+",";
+            for(int k=0;k<TIER_N;++k) opt.tiers[k] = list.find(std::string(",")+tier_names[k]+",")!=std::string::npos;
+        }
+        else if(a[0]=='-') return false;
+        else{
+            bool found = false;
+            for(auto& f:funcs) found |= a==f.name;
+            if(!found){ fprintf(stderr,"unknown function %s\n",a.c_str()); return false; }
+            opt.names.push_back(a);
+        }
+    }
+    return true;
+}
+
+int main(int argc,char** argv){
+    cert_options opt;
+    if(!parse_args(argc,argv,opt)){
+        fprintf(stderr,"usage: %s [-o out.csv] [-t threads] [-s step] [-n] [-T std,normal,fast1,fast2,fast3] [func...]\n",argv[0]);
+        return 2;
+    }
+    FILE* csv = fopen(opt.out,"w");
+    if(!csv){ fprintf(stderr,"cannot open %s\n",opt.out); return 2; }
+    fprintf(csv,"func,tier,inputs,skipped,exempt,nonfinite,max_ulp,worst_ulp_x,max_abs,worst_abs_x,max_rel,worst_rel_x,max_err,worst_err_x,bound,pass\n");
+    printf("FM_TRIG_POLY=%d, %u threads, step %llu%s\n",FM_TRIG_POLY,opt.threads,(unsigned long long)opt.step,opt.no_subnormal?", subnormal inputs skipped":"");
+    bool selected[TIER_N];
+    std::copy(opt.tiers,opt.tiers+TIER_N,selected);
+    opt.tiers[fm::ESpeedStd] |= opt.tiers[fm::ESpeedNormal]; //normal的上界需要std的结果
+    printf("%-9s %-6s %12s %14s %12s %14s %12s %14s %12s %14s %9s %9s %s\n","func","tier","max_ulp","x","max_abs","x","max_rel","x","max_err","x","exempt","nonfinite","");
+    int failed = 0;
+    for(auto& fn:funcs){
+        if(!opt.names.empty() && std::find(opt.names.begin(),opt.names.end(),fn.name)==opt.names.end()) continue;
+        auto t0 = std::chrono::steady_clock::now();
+        cert_result res[TIER_N];
+        uint64_t skipped = certify(fn,opt,res);
+        uint64_t inputs = ((uint64_t)1<<32)/opt.step-skipped;
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+        for(int k=0;k<TIER_N;++k){
+            if(!selected[k]) continue;
+            const cert_result& r = res[k];
+            bool ok = tier_pass(k,res);
+            if(!ok) ++failed;
+            printf("%-9s %-6s %12.4g %14a %12.4g %14a %12.4g %14a %12.4g %14a %9llu %9llu %s\n",fn.name,tier_names[k],
+                r.ulp.v,r.ulp.x,r.abs.v,r.abs.x,r.rel.v,r.rel.x,r.err.v,r.err.x,(unsigned long long)r.exempt,(unsigned long long)r.nonfinite,ok?"ok":"FAILED");
+            fprintf(csv,"%s,%s,%llu,%llu,%llu,%llu,%.17g,%a,%.17g,%a,%.17g,%a,%.17g,%a,%g,%d\n",fn.name,tier_names[k],
+                (unsigned long long)inputs,(unsigned long long)skipped,(unsigned long long)r.exempt,(unsigned long long)r.nonfinite,
+                r.ulp.v,r.ulp.x,r.abs.v,r.abs.x,r.rel.v,r.rel.x,r.err.v,r.err.x,tier_bound(k,res),ok?1:0);
+        }
+        printf("%-9s %llu inputs, %llu skipped, %.1fs\n",fn.name,(unsigned long long)inputs,(unsigned long long)skipped,sec);
+        fflush(stdout);
+    }
+    fclose(csv);
+    if(failed) printf("%d tier(s) FAILED, table written to %s\n",failed,opt.out);
+    else printf("all passed, table written to %s\n",opt.out);
+    return failed?1:0;
+}
@@ -0,0 +1,146 @@
+// 对所有正规格化float输入穷举验证normal档位的误差（以ulp计），参考值为double下的std实现
+// 各函数与误差上界见下方sweeps，多线程分段扫描；另外验证整数参数的log2/exp2/pow路径结果精确
+// 用法：FastMathSweepTest [-s 步长]
+//   -s N 只扫描每第N个位模式，另外扫描log2表每个格子的边界（默认1即穷举，ctest中以-s 64运行，完整扫描见CMakeLists.txt的FM_FULL_SWEEP）
+#include "FastMath.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+struct sweep_result{
+    double max_ulp = 0;
+    float worst = 0;
+};
+
+//float结果y相对参考值ref的误差，以ref所在区间的float ulp为单位
+static double ulp_err(float y,double ref){
+    if(ref==0) return y==0 ? 0 : INFINITY;
+    int e;
+    std::frexp(ref,&e);
+    double ulp = std::ldexp(1.0,std::max(e-24,-149));
+    return std::abs((double)y-ref)/ulp;
+}
+
+template<class F,class R>
+static void sweep_one(F f,R ref,uint32_t i,sweep_result& r){
+    float x;
+    std::memcpy(&x,&i,4);
+    double u = ulp_err(f(x),ref(x));
+    if(!(u<=r.max_ulp)){ r.max_ulp=u; r.worst=x; }
+}
+
+//扫描[lo,hi)中的lo+k*step；step>1时另外扫描log2表（log2、log10、log的normal档位共用）每个格子的边界及其前后各一个位模式，
+//格子边界为尾数低23-_log2_bk位为0处，也包括了每个指数的边界（cbrt的初值在此处不连续）
+template<class F,class R>
+static sweep_result sweep(F f,R ref,uint32_t lo,uint32_t hi,uint32_t step){
+    unsigned nt = std::max(1u,std::thread::hardware_concurrency());
+    const uint64_t n = ((uint64_t)(hi-lo)+step-1)/step;
+    std::vector<sweep_result> part(nt);
+    std::vector<std::thread> th;
+    for(unsigned t=0;t<nt;++t){
+        th.emplace_back([&,t](){
+            uint64_t b = n*t/nt, e = n*(t+1)/nt;
+            sweep_result r;
+            for(uint64_t j=b;j<e;++j) sweep_one(f,ref,lo+(uint32_t)(j*step),r);
+            part[t] = r;
+        });
+    }
+    for(auto& t:th) t.join();
+    sweep_result r;
+    for(auto& p:part) if(!(p.max_ulp<=r.max_ulp)) r = p;
+    if(step>1){
+        const uint32_t cell = 1u<<(23-fm::_log2_bk);
+        for(uint32_t c=lo;c<hi;c+=cell){
+            for(uint32_t i:{c-1,c,c+1}){
+                if(i>=lo && i<hi) sweep_one(f,ref,i,r);
+            }
+        }
+    }
+    return r;
+}
+
+//0、负数、非规格化数、inf、nan应与std一致
+template<class F,class S>
+static bool specials_match(F f,S s){
+    const float xs[] = {0.0f,-0.0f,-1.0f,-INFINITY,INFINITY,NAN,1e-40f,1.4e-45f,-1e-40f};
+    for(float x:xs){
+        float a = f(x), b = s(x);
+        if(!(a==b || (std::isnan(a) && std::isnan(b)))) return false;
+    }
+    return true;
+}
+
+//整数路径：log2_floor/log2_ceil在每个2的幂附近、exp2(int)的所有指数、normal档位pow(int,int)应与std结果完全相同
+static bool integer_paths_exact(){
+    for(int k=0;k<64;++k){
+        uint64_t p = (uint64_t)1<<k;
+        for(uint64_t x:{p-1,p,p+1}){
+            if(x==0) continue;
+            int f = 0, c = 0;
+            while(f<63 && (x>>(f+1))) ++f;
+            while(c<64 && ((uint64_t)1<<c)<x) ++c;
+            if(fm::log2_floor(x)!=f || fm::log2_ceil(x)!=c) return false;
+        }
+    }
+    for(int n=-1100;n<=1100;++n){
+        if(fm::exp2(n)!=std::exp2((double)n)) return false;
+    }
+    static_assert(std::is_same<decltype(fm::pow(2,3)),int>::value && std::is_same<decltype(fm::pow(2.0,3)),double>::value,"pow return type");
+    for(int64_t x=-50;x<=50;++x){
+        for(int y=-8;y<=8;++y){
+            if(x==0 && y<0) continue; //(int64_t)inf
+            int64_t b = (int64_t)std::pow((double)x,y);
+            for(int k=fm::ESpeedStd;k<=fm::ESpeedFast3;++k){
+                if(fm::pow(x,y,(fm::speed_option)k)!=b) return false;
+            }
+        }
+    }
+    //超过2^53时std::pow不精确，normal档位应与整数乘法相同
+    int64_t p3 = 1;
+    for(int y=0;y<=38;++y,p3*=3){
+        if(fm::pow((int64_t)3,y)!=p3 || fm::pow((int64_t)-3,y)!=(y%2 ? -p3 : p3)) return false;
+    }
+    return true;
+}
+
+int main(int argc,char** argv){
+    uint32_t step = 1;
+    for(int i=1;i<argc;++i){
+        if(std::strcmp(argv[i],"-s")==0 && i+1<argc) step = (uint32_t)std::max(1,atoi(argv[++i]));
+        else{
+            fprintf(stderr,"usage: %s [-s step]\n",argv[0]);
+            return 2;
+        }
+    }
+    if(step>1) printf("step %u (plus log2 table cell boundaries)\n",step);
+    int failed = 0;
+    const uint32_t lo = 0x00800000u, hi = 0x7F800000u; //所有正规格化数
+    struct{
+        const char* name;
+        double bound;
+        float (*f)(float);
+        double (*ref)(float);
+        float (*s)(float);
+    } sweeps[] = {
+        {"log2 normal",0.71,[](float x){ return fm::log2(x,fm::ESpeedNormal); },[](float x){ return std::log2((double)x); },[](float x){ return std::log2(x); }},
+        {"log10 normal",0.71,[](float x){ return fm::log10(x,fm::ESpeedNormal); },[](float x){ return std::log10((double)x); },[](float x){ return std::log10(x); }},
+        {"cbrt normal",0.51,[](float x){ return fm::cbrt(x,fm::ESpeedNormal); },[](float x){ return std::cbrt((double)x); },[](float x){ return std::cbrt(x); }},
+        {"log normal",0.71,[](float x){ return fm::log(x,fm::ESpeedNormal); },[](float x){ return std::log((double)x); },[](float x){ return std::log(x); }},
+    };
+    for(auto& s:sweeps){
+        sweep_result r = sweep(s.f,s.ref,lo,hi,step);
+        bool ok = r.max_ulp<=s.bound && specials_match(s.f,s.s);
+        printf("  %-12s max %.4f ulp (x=%a), bound %.2f ulp %s\n",s.name,r.max_ulp,r.worst,s.bound,ok?"ok":"FAILED");
+        if(!ok) ++failed;
+    }
+    bool int_ok = integer_paths_exact();
+    printf("  %-12s %s\n","integer",int_ok?"ok":"FAILED");
+    if(!int_ok) ++failed;
+    printf(failed?"%d check(s) FAILED\n":"all passed\n",failed);
+    return failed?1:0;
+}
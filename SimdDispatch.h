@@ -0,0 +1,71 @@
+// FastMath.h与VecMat.h共用的运行时CPU特性检测（两个库的批量接口各自有一张函数指针表）
+// 批量接口的SIMD版本都以 __attribute__((target(...))) 编译进同一个二进制，
+// 第一次调用批量接口时根据cpuid选出本机支持的最高版本并填入函数指针表，无需针对不同机器分别以-march编译
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    #define SIMD_DISPATCH_X86 1
+    #include <immintrin.h>
+    #define SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define SIMD_DISPATCH_X86 0
+    #define SIMD_TARGET(isa)
+#endif
+
+//定义为0可关闭第一次调用批量接口时的日志
+#ifndef SIMD_DISPATCH_LOG
+    #define SIMD_DISPATCH_LOG 1
+#endif
+
+namespace simd_dispatch{
+
+    enum simd_level{
+        ESimdScalar=0,
+        ESimdSSE41=1,
+        ESimdAVX2=2,
+        ESimdAVX512=3, //AVX-512F
+    };
+
+    inline const char* level_name(const simd_level level){
+        switch(level){
+            case ESimdSSE41: return "sse4.1";
+            case ESimdAVX2: return "avx2";
+            case ESimdAVX512: return "avx512f";
+            default: return "scalar";
+        }
+    }
+
+    //本机支持的最高版本
+    inline simd_level detect(){
+#if SIMD_DISPATCH_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f")) return ESimdAVX512;
+        if(__builtin_cpu_supports("avx2")) return ESimdAVX2;
+        if(__builtin_cpu_supports("sse4.1")) return ESimdSSE41;
+#endif
+        return ESimdScalar;
+    }
+
+    //默认使用的版本：本机支持的最高版本，可用环境变量SIMD_DISPATCH_LEVEL（scalar/sse4.1/avx2/avx512f）再限制
+    inline simd_level startup_level(){
+        simd_level level = detect();
+        const char* env = std::getenv("SIMD_DISPATCH_LEVEL");
+        if(env){
+            for(int l=ESimdScalar;l<=ESimdAVX512;++l){
+                if(std::strcmp(env,level_name((simd_level)l))==0 && l<level) level=(simd_level)l;
+            }
+        }
+        return level;
+    }
+
+    inline void log(const char* lib,const simd_level level){
+#if SIMD_DISPATCH_LOG
+        std::fprintf(stderr,"[%s] simd dispatch: %s (cpu supports %s)\n",lib,level_name(level),level_name(detect()));
+#endif
+    }
+
+}//namespace simd_dispatch
@@ -0,0 +1,481 @@
+// 运行时SIMD分派的测试：依次强制使用本机支持的每个版本，检查批量接口与标量版本的结果一致
+// 各版本都与标量fm::sin/cos/tan/sincos、vecmat的mat*vec比较；AVX-512版本中乘加会被合并为FMA，允许1e-6级别的差异
+// 多项式法的sin/cos/tan/sincos（FM_TRIG_POLY=1时的fast档位）经函数指针表直接调用，与标量sin_poly等比较
+// tanh sinh cosh erf sigmoid softplus的SIMD版本fast3与标量版本不同（见FastMathBatch.inl.h），与精确值比较各档位的误差上限
+// expm1 log10 log1p cbrt hypot atan atan2的SIMD版本与标量版本的计算相同，同样与精确值比较各档位的误差上限（atan atan2另外测试double数组）
+// rsqrt各版本的初值不同（rsqrtps/rsqrt14ps），pow的标量版本fast1/fast2调用std，这两个函数与精确值比较各档位的误差上限（另测标量pown的gamma校正指数）
+
+#include "FastMath.h"
+#include "VecMat.h"
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+static int failed = 0;
+
+static void check(bool ok,const char* lib,simd_dispatch::simd_level level,const char* what,double err){
+    printf("  [%s] %-8s %-10s max diff %.3g %s\n",lib,simd_dispatch::level_name(level),what,err,ok?"ok":"FAILED");
+    if(!ok) ++failed;
+}
+
+static void test_fastmath(simd_dispatch::simd_level level,const std::vector<float>& in){
+    size_t n = in.size();
+    std::vector<float> s(n),c(n),t(n),s2(n),c2(n),ip(in);
+    fm::sin(in.data(),s.data(),n,fm::ESpeedFast1);
+    fm::cos(in.data(),c.data(),n,fm::ESpeedFast1);
+    fm::tan(in.data(),t.data(),n,fm::ESpeedFast1);
+    fm::sincos(in.data(),s2.data(),c2.data(),n,fm::ESpeedFast1);
+    fm::sin(ip.data(),ip.data(),n,fm::ESpeedFast1);//原地计算
+    double es=0,ec=0,et=0,esc=0,eip=0;
+    for(size_t i=0;i<n;++i){
+        float x = in[i];
+        float rs = fm::sin(x,fm::ESpeedFast1), rc = fm::cos(x,fm::ESpeedFast1), rt = fm::tan(x,fm::ESpeedFast1);
+        es = std::max(es,(double)std::abs(s[i]-rs));
+        ec = std::max(ec,(double)std::abs(c[i]-rc));
+        et = std::max(et,(double)std::abs(t[i]-rt)/std::max(1.0f,std::abs(rt)));
+        esc = std::max(esc,(double)std::max(std::abs(s2[i]-rs),std::abs(c2[i]-rc)));
+        eip = std::max(eip,(double)std::abs(ip[i]-rs));
+    }
+    check(es<=1e-6,"FastMath",level,"sin",es);
+    check(ec<=1e-6,"FastMath",level,"cos",ec);
+    check(et<=1e-5,"FastMath",level,"tan",et);
+    check(esc<=1e-6,"FastMath",level,"sincos",esc);
+    check(eip<=1e-6,"FastMath",level,"in-place",eip);
+}
+
+//多项式法（FM_TRIG_POLY=1时的fast档位）直接经函数指针表调用，与标量版本sin_poly等比较
+template<int Deg>
+static void test_trig_poly(simd_dispatch::simd_level level,const std::vector<float>& in,const fm::speed_option speed,const char* const names[4]){
+    size_t n = in.size();
+    std::vector<float> s(n),c(n),t(n),s2(n),c2(n);
+    fm::_batch_table().sin_poly(in.data(),s.data(),n,0.0f,speed);
+    fm::_batch_table().sin_poly(in.data(),c.data(),n,0.5f,speed);
+    fm::_batch_table().tan_poly(in.data(),t.data(),n,speed);
+    fm::_batch_table().sincos_poly(in.data(),s2.data(),c2.data(),n,speed);
+    double es=0,ec=0,et=0,esc=0;
+    for(size_t i=0;i<n;++i){
+        float x = in[i], rs2, rc2;
+        float rs = fm::sin_poly<Deg>(x), rc = fm::cos_poly<Deg>(x), rt = fm::tan_poly<Deg>(x);
+        fm::sincos_poly<Deg>(x,&rs2,&rc2);
+        es = std::max(es,(double)std::abs(s[i]-rs));
+        ec = std::max(ec,(double)std::abs(c[i]-rc));
+        et = std::max(et,(double)std::abs(t[i]-rt)/std::max(1.0f,std::abs(rt)));
+        esc = std::max(esc,(double)std::max(std::abs(s2[i]-rs2),std::abs(c2[i]-rc2)));
+    }
+    check(es<=1e-6,"FastMath",level,names[0],es);
+    check(ec<=1e-6,"FastMath",level,names[1],ec);
+    check(et<=1e-5,"FastMath",level,names[2],et);
+    check(esc<=1e-6,"FastMath",level,names[3],esc);
+}
+
+static void test_trig_poly(simd_dispatch::simd_level level,const std::vector<float>& in){
+    const char* const f1[4] = {"sin p7","cos p7","tan p7","sincos p7"};
+    const char* const f2[4] = {"sin p5","cos p5","tan p5","sincos p5"};
+    const char* const f3[4] = {"sin p3","cos p3","tan p3","sincos p3"};
+    test_trig_poly<7>(level,in,fm::ESpeedFast1,f1);
+    test_trig_poly<5>(level,in,fm::ESpeedFast2,f2);
+    test_trig_poly<3>(level,in,fm::ESpeedFast3,f3);
+}
+
+static void test_rsqrt(simd_dispatch::simd_level level,const std::vector<float>& in){
+    size_t n = in.size();
+    std::vector<float> x(n),r(n);
+    for(size_t i=0;i<n;++i) x[i] = std::abs(in[i]);
+    const float special[] = {0.0f,-0.0f,1e-40f,std::numeric_limits<float>::infinity(),std::numeric_limits<float>::quiet_NaN(),-1.0f};
+    for(size_t i=0,k=0;i<n;i+=101,++k) x[i] = special[k%6];
+    const fm::speed_option speeds[] = {fm::ESpeedNormal,fm::ESpeedFast1,fm::ESpeedFast2};
+    const char* names[] = {"rsqrt n","rsqrt f1","rsqrt f2"};
+    const double bound[] = {2e-7,3e-7,3.3e-4};
+    for(int k=0;k<3;++k){
+        fm::rsqrt(x.data(),r.data(),n,speeds[k]);
+        double e=0;
+        bool special_ok=true;
+        for(size_t i=0;i<n;++i){
+            float ref = 1/std::sqrt(x[i]);
+            //normal档位（sqrtps+divps）对所有输入（包括0、非规格化数、inf、nan、负数）与1/std::sqrt逐位一致，fast档位对这些输入不保证
+            if(speeds[k]==fm::ESpeedNormal && !(r[i]==ref || (std::isnan(r[i]) && std::isnan(ref)))) special_ok=false;
+            if(!(x[i]>=std::numeric_limits<float>::min() && x[i]<std::numeric_limits<float>::infinity())) continue;
+            double exact = 1/std::sqrt((double)x[i]);
+            e = std::max(e,std::abs(r[i]-exact)/exact);
+        }
+        check(e<=bound[k] && special_ok,"FastMath",level,names[k],e);
+    }
+}
+
+static void test_pow(simd_dispatch::simd_level level,const std::vector<float>& in){
+    size_t n = in.size();
+    std::vector<float> x(n),y(n),r(n);
+    for(size_t i=0;i<n;++i){
+        x[i] = std::abs(in[i])*0.05f;
+        y[i] = in[(i*7)%n]*0.05f;
+    }
+    for(size_t i=0;i<n;i+=89) x[i] = (i/89)%2 ? 0.0f : -2.0f;//x<=0时调用std::pow
+    const fm::speed_option speeds[] = {fm::ESpeedFast1,fm::ESpeedFast2,fm::ESpeedFast3};
+    const char* names[] = {"pow f1","pow f2","pow f3"};
+    const double bound[] = {3.1e-5,1e-4,3.7e-3};
+    for(int k=0;k<3;++k){
+        fm::pow(x.data(),y.data(),r.data(),n,speeds[k]);
+        double e=0;
+        bool special_ok=true;
+        for(size_t i=0;i<n;++i){
+            if(!(x[i]>0)){
+                float ref = std::pow(x[i],y[i]);
+                if(!(r[i]==ref || (std::isnan(r[i]) && std::isnan(ref)))) special_ok=false;
+                continue;
+            }
+            double exact = std::pow((double)x[i],(double)y[i]);
+            if(!(exact>=std::numeric_limits<float>::min() && exact<=std::numeric_limits<float>::max())) continue;
+            e = std::max(e,std::abs(r[i]-exact)/exact);
+        }
+        check(e<=bound[k] && special_ok,"FastMath",level,names[k],e);
+    }
+    //标量pown的gamma校正指数（x^2.2、x^(5/12)，初值加Halley迭代），fast2与fast1相同；x为0时为0，负数为nan
+    const char* pown_names[][2] = {{"pown 11/5 f1","pown 11/5 f3"},{"pown 5/12 f1","pown 5/12 f3"}};
+    const fm::speed_option pown_speeds[] = {fm::ESpeedFast1,fm::ESpeedFast3};
+    const double pown_bound[] = {6.5e-7,3.1e-3};
+    for(int p=0;p<2;++p){
+        for(int k=0;k<2;++k){
+            double e=0;
+            bool special_ok=true;
+            for(size_t i=0;i<n;++i){
+                float r = p==0 ? fm::pown<11,5>(x[i],pown_speeds[k]) : fm::pown<5,12>(x[i],pown_speeds[k]);
+                double exact = std::pow((double)x[i],p==0 ? 2.2 : 5.0/12);
+                if(!(x[i]>0)){
+                    if(!(x[i]==0 ? r==0 : std::isnan(r))) special_ok=false;
+                    continue;
+                }
+                if(!(exact>=std::numeric_limits<float>::min() && exact<=std::numeric_limits<float>::max())) continue;
+                e = std::max(e,std::abs(r-exact)/exact);
+            }
+            check(e<=pown_bound[k] && special_ok,"FastMath",level,pown_names[p][k],e);
+        }
+    }
+    //编译期档位的pown与运行时档位相同；批量pown<5>与逐个计算的标量pown<5>逐位一致
+    bool same=true;
+    std::vector<float> b(n);
+    for(int k=fm::ESpeedStd;k<=fm::ESpeedFast3;++k){
+        fm::pown<5>(x.data(),b.data(),n,(fm::speed_option)k);
+        for(size_t i=0;i<n;++i){
+            float s = fm::pown<5>(x[i],(fm::speed_option)k);
+            if(!(b[i]==s || (std::isnan(b[i]) && std::isnan(s)))) same=false;
+        }
+    }
+    const float t = 0.7f;
+    same = same && fm::pown<fm::ESpeedFast3,11,5>(t)==fm::pown<11,5>(t,fm::ESpeedFast3) && fm::pown<fm::ESpeedNormal,5>(t)==fm::pown<5>(t,fm::ESpeedNormal);
+    check(same,"FastMath",level,"pown template/batch",0);
+}
+
+//exp：结果接近上溢的输入（x*log2(e)接近128，2^k加到指数位上时可能进位）必须在误差上限内（精确结果不超过FLT_MAX时不能为inf），上溢时为inf或FLT_MAX
+//标量fm::exp、fm::exp2的fast1/fast2（与pow共用_exp2_kernel）同样检查128附近与以上的输入
+static void test_exp(simd_dispatch::simd_level level,const std::vector<float>& in){
+    size_t n = in.size();
+    std::vector<float> r(n);
+    for(size_t i=0;i<n;++i) r[i] = in[i]*0.87f;
+    const float near_overflow[] = {88.0f,88.5f,88.7f,88.72f,0x1.62e3f0p+6f,0x1.62e406p+6f,0x1.62e42ep+6f,0x1.62e430p+6f,88.7229f,88.73f,89.0f,100.0f,1e30f,
+                                   std::numeric_limits<float>::infinity()};
+    const size_t n_near = sizeof(near_overflow)/sizeof(near_overflow[0]);
+    for(size_t i=0,k=0;i<n;i+=53,++k) r[i] = near_overflow[k%n_near];
+    const fm::speed_option speeds[] = {fm::ESpeedFast1,fm::ESpeedFast2,fm::ESpeedFast3};
+    const char* names[] = {"exp f1","exp f2","exp f3"};
+    const double bound[] = {6.5e-6,1.8e-3,4e-2};
+    const float inf = std::numeric_limits<float>::infinity();
+    for(int k=0;k<3;++k){
+        std::vector<float> x(r);
+        fm::exp(x.data(),x.data(),n,speeds[k]);//原地计算
+        double e=0;
+        bool overflow_ok=true;
+        for(size_t i=0;i<n;++i){
+            double exact = std::exp((double)r[i]);
+            if(std::isnan(exact)) continue;
+            if(!(exact<=std::numeric_limits<float>::max())){
+                //精确结果略超过FLT_MAX时可以为FLT_MAX；fast3的标量版本（_exp2_bits）上溢时约为3.3e38而不是inf
+                if(x[i]!=inf && x[i]!=std::numeric_limits<float>::max() && speeds[k]!=fm::ESpeedFast3) overflow_ok=false;
+                continue;
+            }
+            e = std::max(e,std::min(std::abs(x[i]-exact),std::abs(x[i]-exact)/exact));
+        }
+        check(e<=bound[k] && overflow_ok,"FastMath",level,names[k],e);
+    }
+    const float xs[] = {127.0f,127.5f,127.9f,127.99f,127.9999f,0x1.fffff0p+6f,0x1.fffffep+6f,128.0f,128.0001f,128.5f,130.0f,1e30f,inf};
+    const char* exp2_names[] = {"exp2 f1","exp2 f2"};
+    const char* exp_names[] = {"exp f1 (scalar)","exp f2 (scalar)"};
+    for(int k=0;k<2;++k){
+        double e=0,ee=0;
+        bool overflow_ok=true,exp_overflow_ok=true;
+        for(float v:xs){
+            float y = fm::exp2(v,speeds[k]);
+            double exact = std::exp2((double)v);
+            if(!(exact<=std::numeric_limits<float>::max())){
+                if(y!=inf) overflow_ok=false;
+                continue;
+            }
+            e = std::max(e,std::abs(y-exact)/exact);
+        }
+        for(float v:near_overflow){
+            float y = fm::exp(v,speeds[k]);
+            double exact = std::exp((double)v);
+            if(!(exact<=std::numeric_limits<float>::max())){
+                if(y!=inf && y!=std::numeric_limits<float>::max()) exp_overflow_ok=false;
+                continue;
+            }
+            ee = std::max(ee,std::abs(y-exact)/exact);
+        }
+        check(e<=bound[k] && overflow_ok,"FastMath",level,exp2_names[k],e);
+        check(ee<=bound[k] && exp_overflow_ok,"FastMath",level,exp_names[k],ee);
+    }
+    //标量fast3（_exp2_bits，批量版本的fast3为_exp2_kernel<2>）：下溢时结果须接近0（绝对误差在上限内），上溢时须为有限的正数
+    const float xs3[] = {-1e30f,-200.0f,-150.0f,-128.0f,-127.0f,-126.5f,-126.0f,-125.0f,-103.0f,-100.0f,-90.0f,-88.0f,-87.0f,-10.0f,0.5f,
+                         80.0f,88.0f,89.0f,127.0f,128.0f,130.0f,1e30f,-inf,inf};
+    const char* f3_names[] = {"exp f3 (scalar)","exp2 f3 (scalar)"};
+    for(int k=0;k<2;++k){
+        double e=0;
+        bool range_ok=true;
+        for(float v:xs3){
+            float y = k==0 ? fm::exp(v,fm::ESpeedFast3) : fm::exp2(v,fm::ESpeedFast3);
+            double exact = k==0 ? std::exp((double)v) : std::exp2((double)v);
+            if(!(y>=0 && y<inf)) range_ok=false;
+            if(!(exact<=std::numeric_limits<float>::max())) continue;
+            e = std::max(e,std::min(std::abs(y-exact),std::abs(y-exact)/exact));
+        }
+        check(e<=bound[2] && range_ok,"FastMath",level,f3_names[k],e);
+    }
+}
+
+//tanh sinh cosh erf sigmoid softplus，与精确值比较各档位的误差上限（标量版本的fast3误差较大，sigmoid softplus的fast1调用std）
+static void test_exp_family(simd_dispatch::simd_level level,const std::vector<float>& in){
+    typedef void (*batch_func)(const float*,float*,size_t,const fm::speed_option);
+    const batch_func funcs[] = {fm::tanh,fm::sinh,fm::cosh,fm::erf,fm::sigmoid,fm::softplus};
+    const char* names[][3] = {{"tanh f1","tanh f2","tanh f3"},{"sinh f1","sinh f2","sinh f3"},{"cosh f1","cosh f2","cosh f3"},
+                              {"erf f1","erf f2","erf f3"},{"sigmoid f1","sigmoid f2","sigmoid f3"},{"softplus f1","softplus f2","softplus f3"}};
+    const double bound[][3] = {{1.42e-6,8.6e-4,2.01e-2},{9.1e-6,1.03e-4,1.03e-4},{9.1e-6,8.2e-5,8.2e-5},
+                               {1.95e-6,4.7e-4,2.42e-2},{7.1e-7,4.3e-4,1.01e-2},{1.35e-6,7.8e-4,1.5e-2}};
+    const fm::speed_option speeds[] = {fm::ESpeedFast1,fm::ESpeedFast2,fm::ESpeedFast3};
+    size_t n = in.size();
+    std::vector<float> x(n),r(n);
+    for(size_t i=0;i<n;++i) x[i] = in[i]*0.87f;//含大输入与inf、nan
+    //sinh cosh在|x|>88.7（e^|x|上溢）而结果未上溢（|x|<89.4）时须在误差上限内，结果上溢时须为inf
+    const float near_overflow[] = {87.5f,88.0f,88.72f,89.0f,89.4f,89.41f,89.42f,90.0f,100.0f};
+    for(size_t i=0,k=0;i<n;i+=61,++k) x[i] = k%2 ? -near_overflow[k/2%9] : near_overflow[k/2%9];
+    for(int f=0;f<6;++f){
+        for(int k=0;k<3;++k){
+            funcs[f](x.data(),r.data(),n,speeds[k]);
+            double e=0;
+            bool overflow_ok=true;
+            for(size_t i=0;i<n;++i){
+                double d = x[i], exact;
+                switch(f){
+                    case 0: exact = std::tanh(d); break;
+                    case 1: exact = std::sinh(d); break;
+                    case 2: exact = std::cosh(d); break;
+                    case 3: exact = std::erf(d); break;
+                    case 4: exact = 1/(1+std::exp(-d)); break;
+                    default: exact = std::max(d,0.0)+std::log1p(std::exp(-std::abs(d))); break;
+                }
+                if(std::isnan(d)) continue;
+                if(!(std::abs(exact)<=std::numeric_limits<float>::max())){
+                    if(r[i]!=(float)exact) overflow_ok=false;//±inf
+                    continue;
+                }
+                e = std::max(e,std::min(std::abs(r[i]-exact),std::abs(r[i]-exact)/std::abs(exact)));
+            }
+            check(e<=bound[f][k] && overflow_ok,"FastMath",level,names[f][k],e);
+        }
+    }
+}
+
+//expm1 log10 log1p cbrt hypot，与精确值比较各档位的误差上限（SIMD版本与标量版本的计算相同）
+static void test_log_family(simd_dispatch::simd_level level,const std::vector<float>& in){
+    typedef void (*batch_func)(const float*,float*,size_t,const fm::speed_option);
+    const batch_func funcs[] = {fm::expm1,fm::log10,fm::log1p,fm::cbrt};
+    const char* names[][3] = {{"expm1 f1","expm1 f2","expm1 f3"},{"log10 f1","log10 f2","log10 f3"},
+                              {"log1p f1","log1p f2","log1p f3"},{"cbrt f1","cbrt f2","cbrt f3"}};
+    const double bound[][3] = {{9.8e-6,2.8e-4,6.4e-3},{1.8e-7,3.5e-6,3.5e-6},{1.9e-7,7.8e-6,7.8e-6},{2.1e-5,9.94e-4,3.16e-2}};
+    const fm::speed_option speeds[] = {fm::ESpeedFast1,fm::ESpeedFast2,fm::ESpeedFast3};
+    size_t n = in.size();
+    std::vector<float> x(n),r(n);
+    for(int f=0;f<4;++f){
+        for(size_t i=0;i<n;++i){
+            switch(f){
+                case 0: x[i] = in[i]*0.87f; break;//含x>88.7（结果上溢）与inf、nan
+                case 1: x[i] = std::abs(in[i]); break;
+                case 2: x[i] = in[i]<0 ? in[i]*0.0099f : in[i]; break;//(-1,0]与大输入
+                default: x[i] = in[i]; break;
+            }
+        }
+        for(int k=0;k<3;++k){
+            funcs[f](x.data(),r.data(),n,speeds[k]);
+            double e=0;
+            for(size_t i=0;i<n;++i){
+                double d = x[i], exact;
+                switch(f){
+                    case 0: exact = std::expm1(d); break;
+                    case 1: exact = std::log10(d); break;
+                    case 2: exact = std::log1p(d); break;
+                    default: exact = std::cbrt(d); break;
+                }
+                if(!(std::abs(exact)<=std::numeric_limits<float>::max()) || (f!=0 && std::abs(d)<std::numeric_limits<float>::min())) continue;
+                e = std::max(e,std::min(std::abs(r[i]-exact),std::abs(r[i]-exact)/std::abs(exact)));
+            }
+            check(e<=bound[f][k],"FastMath",level,names[f][k],e);
+        }
+    }
+    //hypot：fast档位先按max(|x|,|y|)的指数缩放，平方在float下不会上溢（|x|、|y|超过1.8e19）或下溢，结果超过FLT_MAX时须为inf
+    std::vector<float> hx(in),hy(in.rbegin(),in.rend());
+    const float large[] = {2e19f,3e19f,-4e19f,1e30f,1e38f,-2e38f,2.4e38f,3e38f,3.4e38f,1e-20f,-1e-30f,1e-39f};
+    for(size_t i=0,k=0;i<n;i+=37,++k){
+        hx[i] = large[k%12];
+        if(k%3) hy[i] = large[(k*5+1)%12];
+    }
+    const fm::speed_option hypot_speeds[] = {fm::ESpeedFast1,fm::ESpeedFast2,fm::ESpeedFast3};
+    const char* hypot_names[] = {"hypot f1","hypot f2","hypot f3"};
+    for(int k=0;k<3;++k){
+        fm::hypot(hx.data(),hy.data(),r.data(),n,hypot_speeds[k]);
+        double e=0;
+        bool overflow_ok=true;
+        for(size_t i=0;i<n;++i){
+            if(std::isnan(hx[i]) || std::isnan(hy[i]) || std::isinf(hx[i]) || std::isinf(hy[i])) continue;
+            double exact = std::hypot((double)hx[i],(double)hy[i]);
+            if(!(exact<=std::numeric_limits<float>::max())){
+                if(r[i]!=std::numeric_limits<float>::infinity()) overflow_ok=false;
+                continue;
+            }
+            e = std::max(e,std::min(std::abs(r[i]-exact),std::abs(r[i]-exact)/exact));
+        }
+        float s = fm::hypot(3e19f,4e19f,hypot_speeds[k]);//标量
+        if(std::abs(s-5e19)>5e19*1.2e-7) overflow_ok=false;
+        check(e<=1.2e-7 && overflow_ok,"FastMath",level,hypot_names[k],e);
+    }
+}
+
+//atan atan2（float与double数组），与精确值比较各档位的误差上限（SIMD版本与标量版本的计算相同）
+static void test_atan(simd_dispatch::simd_level level,const std::vector<float>& in){
+    const char* names[][3] = {{"atan f1","atan f2","atan f3"},{"atan2 f1","atan2 f2","atan2 f3"},
+                              {"atan(d) f1","atan(d) f2","atan(d) f3"},{"atan2(d) f1","atan2(d) f2","atan2(d) f3"}};
+    const double bound[] = {8.2e-5,6.1e-4,5e-3};
+    const fm::speed_option speeds[] = {fm::ESpeedFast1,fm::ESpeedFast2,fm::ESpeedFast3};
+    size_t n = in.size();
+    std::vector<float> y(in.rbegin(),in.rend()),r(n),r2(n);
+    std::vector<double> xd(in.begin(),in.end()),yd(y.begin(),y.end()),rd(n),rd2(n);
+    auto err = [](double v,double exact){ return std::min(std::abs(v-exact),std::abs(v-exact)/std::abs(exact)); };
+    for(int k=0;k<3;++k){
+        fm::atan(in.data(),r.data(),n,speeds[k]);
+        fm::atan2(y.data(),in.data(),r2.data(),n,speeds[k]);
+        fm::atan(xd.data(),rd.data(),n,speeds[k]);
+        fm::atan2(yd.data(),xd.data(),rd2.data(),n,speeds[k]);
+        double e[4] = {0,0,0,0};
+        for(size_t i=0;i<n;++i){
+            if(std::isnan(in[i]) || std::isnan(y[i])) continue;
+            double a = std::atan(xd[i]);
+            e[0] = std::max(e[0],err(r[i],a));
+            e[2] = std::max(e[2],err(rd[i],a));
+            if(std::isinf(in[i]) && std::isinf(y[i])) continue;
+            double a2 = std::atan2(yd[i],xd[i]);
+            e[1] = std::max(e[1],err(r2[i],a2));
+            e[3] = std::max(e[3],err(rd2[i],a2));
+        }
+        for(int f=0;f<4;++f) check(e[f]<=bound[k],"FastMath",level,names[f][k],e[f]);
+    }
+    //x、y为+-0时与std相同，凑满一组SIMD通道
+    std::vector<float> zy(16),zx(16),zr(16);
+    for(int i=0;i<16;++i){ zy[i] = (i&1) ? -0.0f : 0.0f; zx[i] = (i&2) ? -0.0f : ((i&4) ? 1.0f : 0.0f); }
+    fm::atan2(zy.data(),zx.data(),zr.data(),16,fm::ESpeedFast1);
+    bool zero_ok = true;
+    for(int i=0;i<16;++i){
+        float s = std::atan2(zy[i],zx[i]);
+        zero_ok = zero_ok && std::abs(zr[i]-s)<=1e-6f && std::signbit(zr[i])==std::signbit(s);
+    }
+    check(zero_ok,"FastMath",level,"atan2 zeros",0);
+}
+
+static void test_vecmat(simd_dispatch::simd_level level,const std::vector<float>& in){
+    vecmat::mat44f m;
+    for(int i=0;i<4;++i)
+        for(int j=0;j<4;++j) m[i][j] = in[i*4+j]*0.01f;
+    size_t n = in.size()/4 - 1;//不是4的倍数，覆盖尾部
+    std::vector<vecmat::vec4f> v(n),out(n);
+    for(size_t i=0;i<n;++i) v[i] = vecmat::vec4f(in.data()+4*i);
+    vecmat::transform(m,v.data(),out.data(),n);
+    double e=0;
+    for(size_t i=0;i<n;++i){
+        vecmat::vec4f r = m*v[i];
+        for(int j=0;j<4;++j){
+            //相对于各项绝对值之和计算误差（各项相消时结果本身的相对误差没有意义）
+            float scale = 1.0f;
+            for(int k=0;k<4;++k) scale += std::abs(m[j][k]*v[i][k]);
+            e = std::max(e,(double)std::abs(out[i][j]-r[j])/scale);
+        }
+    }
+    check(e<=1e-6,"VecMat",level,"transform",e);
+}
+
+//vec::normalized（不经过SIMD分派，各版本结果相同）：各档位与double（long double）下的精确值比较，分量的绝对误差
+//std/normal/fast1为 *this/len()，fast2/fast3为 *this*fm::rsqrt(dot)（误差见rsqrt的fast2档位）
+template<uint32_t N,typename T>
+static void test_normalized(simd_dispatch::simd_level level,const std::vector<float>& in,const char* const names[5]){
+    const double exact_bound = sizeof(T)==4 ? 3e-7 : 1e-15;
+    const double bound[] = {exact_bound,exact_bound,exact_bound,3.3e-4,3.3e-4};
+    for(int k=0;k<5;++k){
+        double e=0;
+        for(size_t i=0;i+N<=in.size();i+=N){
+            vecmat::vec<N,T> v;
+            bool usable = true;
+            for(uint32_t j=0;j<N;++j){
+                v[j] = (T)in[i+j];
+                usable &= std::abs(in[i+j])<=1e3f;//跳过混入的大输入、inf、nan
+            }
+            if(!usable) continue;
+            long double len=0;
+            for(uint32_t j=0;j<N;++j) len += (long double)v[j]*v[j];
+            len = std::sqrt(len);
+            if(len==0) continue;
+            vecmat::vec<N,T> r = v.normalized((fm::speed_option)k);
+            for(uint32_t j=0;j<N;++j) e = std::max(e,(double)std::abs(r[j]-v[j]/len));
+        }
+        check(e<=bound[k],"VecMat",level,names[k],e);
+    }
+}
+
+int main(){
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> u(-100.0f,100.0f);
+    std::vector<float> in(4099);//不是向量宽度的倍数
+    for(float& x:in) x = u(rng);
+    //混入需要走Payne-Hanek的大输入与inf、nan
+    for(size_t i=0;i<in.size();i+=97){
+        uint32_t b = (uint32_t)rng() & 0x7FFFFFFF;
+        std::memcpy(&in[i],&b,4);
+    }
+
+    simd_dispatch::simd_level best = simd_dispatch::detect();
+    printf("cpu supports: %s\n",simd_dispatch::level_name(best));
+    for(int l=simd_dispatch::ESimdScalar;l<=best;++l){
+        simd_dispatch::simd_level level = (simd_dispatch::simd_level)l;
+        if(fm::set_simd_level(level)!=level || vecmat::set_simd_level(level)!=level){
+            printf("  cannot force %s\n",simd_dispatch::level_name(level));
+            ++failed;
+            continue;
+        }
+        test_fastmath(level,in);
+        test_trig_poly(level,in);
+        test_rsqrt(level,in);
+        test_pow(level,in);
+        test_exp(level,in);
+        test_exp_family(level,in);
+        test_log_family(level,in);
+        test_atan(level,in);
+        test_vecmat(level,in);
+        const char* n2f[] = {"normalized2f std","normalized2f n","normalized2f f1","normalized2f f2","normalized2f f3"};
+        const char* n3f[] = {"normalized3f std","normalized3f n","normalized3f f1","normalized3f f2","normalized3f f3"};
+        const char* n4f[] = {"normalized4f std","normalized4f n","normalized4f f1","normalized4f f2","normalized4f f3"};
+        const char* n3d[] = {"normalized3d std","normalized3d n","normalized3d f1","normalized3d f2","normalized3d f3"};
+        test_normalized<2,float>(level,in,n2f);
+        test_normalized<3,float>(level,in,n3f);
+        test_normalized<4,float>(level,in,n4f);
+        test_normalized<3,double>(level,in,n3d);
+    }
+    printf(failed?"%d check(s) FAILED\n":"all passed\n",failed);
+    return failed?1:0;
+}
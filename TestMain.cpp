@@ -270,6 +270,105 @@ T test_framework_binary<T>::gen[MAX_DATA_N_B];
 
 using fm::pi_f;
 
+// exp2：直接构造指数位的 fm::exp2(x) 与经 fm::exp(x*ln2) 计算的对比，第一列为std::exp2
+template<fm::speed_option S>
+void bench_exp2_chain(){
+    my_rd_real_eng<float> myeg(-30,30);
+    test_framework_unary<float> tp(myeg,20,MAX_DATA_N-5);
+    tp.add_func([](float x)->float{return std::exp2(x);});
+    tp.add_func([](float x)->float{return fm::exp(x*0.6931471805599453f,S);});
+    tp.add_func([](float x)->float{return fm::exp2(x,S);});
+    tp.set_err_standard([](float x)->float{return (float)std::exp2((double)x);});
+    tp.runtest(1);
+}
+
+// tanh sinh cosh erf sigmoid softplus：依次为std（sigmoid softplus为按定义计算）、fast1、fast2、fast3
+#define BENCH_EXP_FAMILY(func,exact,lo,hi) { \
+    printf("%s\n",#func); \
+    my_rd_real_eng<float> myeg(lo,hi); \
+    test_framework_unary<float> tp(myeg,20,MAX_DATA_N-5); \
+    tp.add_func([](float x)->float{return fm::func(x,fm::ESpeedStd);}); \
+    tp.add_func([](float x)->float{return fm::func(x,fm::ESpeedFast1);}); \
+    tp.add_func([](float x)->float{return fm::func(x,fm::ESpeedFast2);}); \
+    tp.add_func([](float x)->float{return fm::func(x,fm::ESpeedFast3);}); \
+    tp.set_err_standard([](float x)->float{double d=x; return (float)(exact);}); \
+    tp.runtest(1); \
+}
+void bench_exp_family(){
+    BENCH_EXP_FAMILY(tanh,std::tanh(d),-10,10);
+    BENCH_EXP_FAMILY(sinh,std::sinh(d),-20,20);
+    BENCH_EXP_FAMILY(cosh,std::cosh(d),-20,20);
+    BENCH_EXP_FAMILY(erf,std::erf(d),-5,5);
+    BENCH_EXP_FAMILY(sigmoid,1/(1+std::exp(-d)),-20,20);
+    BENCH_EXP_FAMILY(softplus,std::max(d,0.0)+std::log1p(std::exp(-std::abs(d))),-20,20);
+}
+
+// 各档位（含normal）与std的用时与误差：log10 log1p expm1 cbrt hypot
+#define BENCH_TIERS(func,exact,lo,hi) { \
+    printf("%s\n",#func); \
+    my_rd_real_eng<float> myeg(lo,hi); \
+    test_framework_unary<float> tp(myeg,20,MAX_DATA_N-5); \
+    tp.add_func([](float x)->float{return fm::func(x,fm::ESpeedStd);}); \
+    tp.add_func([](float x)->float{return fm::func(x,fm::ESpeedNormal);}); \
+    tp.add_func([](float x)->float{return fm::func(x,fm::ESpeedFast1);}); \
+    tp.add_func([](float x)->float{return fm::func(x,fm::ESpeedFast2);}); \
+    tp.add_func([](float x)->float{return fm::func(x,fm::ESpeedFast3);}); \
+    tp.set_err_standard([](float x)->float{double d=x; return (float)(exact);}); \
+    tp.runtest(1); \
+}
+void bench_log_family(){
+    BENCH_TIERS(log10,std::log10(d),1e-3,1e3);
+    BENCH_TIERS(log1p,std::log1p(d),-0.9,100);
+    BENCH_TIERS(expm1,std::expm1(d),-10,10);
+    BENCH_TIERS(cbrt,std::cbrt(d),-1e3,1e3);
+    printf("hypot\n");
+    my_rd_real_eng<float> myeg1(-1e3,1e3),myeg2(-1e3,1e3);
+    test_framework_binary<float> tp(myeg1,myeg2,20,MAX_DATA_N_B-5);
+    tp.add_func([](float x,float y)->float{return fm::hypot(x,y,fm::ESpeedStd);});
+    tp.add_func([](float x,float y)->float{return fm::hypot(x,y,fm::ESpeedNormal);});
+    tp.add_func([](float x,float y)->float{return fm::hypot(x,y,fm::ESpeedFast1);});
+    tp.set_err_standard([](float x,float y)->float{return (float)std::hypot((double)x,(double)y);});
+    tp.runtest(1);
+}
+
+// atan atan2：依次为std、fast1、fast2、fast3
+void bench_atan(){
+    BENCH_EXP_FAMILY(atan,std::atan(d),-10,10);
+    printf("atan2\n");
+    my_rd_real_eng<float> myeg1(-10,10),myeg2(-10,10);
+    test_framework_binary<float> tp(myeg1,myeg2,20,MAX_DATA_N_B-5);
+    tp.add_func([](float y,float x)->float{return fm::atan2(y,x,fm::ESpeedStd);});
+    tp.add_func([](float y,float x)->float{return fm::atan2(y,x,fm::ESpeedFast1);});
+    tp.add_func([](float y,float x)->float{return fm::atan2(y,x,fm::ESpeedFast2);});
+    tp.add_func([](float y,float x)->float{return fm::atan2(y,x,fm::ESpeedFast3);});
+    tp.set_err_standard([](float y,float x)->float{return (float)std::atan2((double)y,(double)x);});
+    tp.runtest(1);
+}
+
+// 整数参数的log2/exp2/pow：依次为std与fm各档位的用时（整数输入不适用于上面的测试框架，误差见FastMathSweepTest）
+#define BENCH_INT(name,T,gen,stdexpr,fmexpr) { \
+    static T in[MAX_DATA_N]; static double out[MAX_DATA_N]; \
+    std::default_random_engine e(time(NULL)); \
+    for(int i=0;i<MAX_DATA_N;++i) in[i]=(T)(gen); \
+    for(int i=0;i<MAX_DATA_N;++i){ T x=in[i]; out[i]=(stdexpr); } \
+    printf("%-12s",name); \
+    for(int s=-1;s<=fm::ESpeedFast3;++s){ \
+        const fm::speed_option speed=(fm::speed_option)std::max(s,0); (void)speed; \
+        double tbg=(double)clock()/CLOCKS_PER_SEC; \
+        if(s<0) for(int i=0;i<MAX_DATA_N;++i){ T x=in[i]; out[i]=(stdexpr); } \
+        else for(int i=0;i<MAX_DATA_N;++i){ T x=in[i]; out[i]=(fmexpr); } \
+        printf("%10.6lf",(double)clock()/CLOCKS_PER_SEC-tbg); \
+    } \
+    printf("  %g\n",out[e()%MAX_DATA_N]); \
+}
+void bench_int_paths(){
+    BENCH_INT("exp2",int,(int)(e()%2001)-1000,std::exp2(x),fm::exp2(x,speed));
+    BENCH_INT("log2 u64",uint64_t,(((uint64_t)e()<<32)^e())>>(e()%64)|1,std::log2(x),fm::log2(x,speed));
+    BENCH_INT("log2_floor",uint32_t,e()>>(e()%32)|1,std::floor(std::log2(x)),fm::log2_floor(x));
+    BENCH_INT("pow y<=4",int,(int)(e()%9)-4,std::pow(1.5,x),fm::pow(1.5,x,speed));
+    BENCH_INT("pow y<16",int,(int)(e()%31)-15,std::pow(1.5,x),fm::pow(1.5,x,speed));
+}
+
 int main(){
     // float a,b;
     // std::cin>>a>>b;
@@ -288,6 +387,12 @@ int main(){
     // tp.set_err_standard([](float x)->float{return std::totst(x);});
     // tp.runtest(1);
 
+    // bench_exp2_chain<fm::ESpeedFast1>();
+    // bench_exp_family();
+    // bench_log_family();
+    // bench_int_paths();
+    // bench_atan();
+
     // printf("%.6lf %.6lf %.6lf %.6lf\n",
         // fm::atan2(1,0),fm::atan2(-1,0),fm::atan2(0,1),fm::atan2(0,-1));
 
@@ -0,0 +1,309 @@
+// 基准测试框架：计时、预热与重复采样、统计（中位数与其95%置信区间）、结果的表格/CSV/JSON输出
+// 计时：x86上用rdtsc（启动时对steady_clock校准得到每tick的纳秒数），其他平台用steady_clock
+// 每个样本为一次计时的若干遍计算，遍数在预热后确定，使每个样本不短于sample_us，结果换算为每个元素的纳秒数
+// 缓存压力模式（pressure_kb>0）：每批batch个元素计算前读写一遍pressure_kb大小的缓冲区，把查表、输入等挤出各级缓存，
+// 只计时每批的计算（减去空计时的开销），模拟与其他内存访问交错的调用
+// 可选的硬件计数器（Linux perf_event_open）：cycles、instructions、branch misses、L1D read misses，
+// 在所有样本期间计数后换算为每个元素的值；不可用（非Linux、虚拟机、perf_event_paranoid等）时为nan，计时不受影响
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define BENCH_HAS_TSC 1
+#else
+    #define BENCH_HAS_TSC 0
+#endif
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #define BENCH_HAS_PERF 1
+#else
+    #define BENCH_HAS_PERF 0
+#endif
+
+namespace bench{
+
+    inline double now_ns(){
+        return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    struct clock_info{
+        bool tsc = BENCH_HAS_TSC;
+        double tick_ns = 1; //每tick的纳秒数
+        double overhead_ns = 0; //连续两次ticks()的用时（中位数），只在逐批计时时减去
+        const char* name() const { return tsc ? "rdtsc" : "steady_clock"; }
+    };
+    inline clock_info g_clock;
+
+    inline uint64_t ticks(){
+#if BENCH_HAS_TSC
+        if(g_clock.tsc) return __rdtsc();
+#endif
+        return (uint64_t)now_ns();
+    }
+
+    //忙等待ms毫秒，用两种时钟的差求每tick的纳秒数
+    inline void calibrate_clock(bool use_tsc,double ms=50){
+        g_clock.tsc = use_tsc && BENCH_HAS_TSC;
+        g_clock.tick_ns = 1;
+        if(g_clock.tsc){
+            double t0 = now_ns();
+            uint64_t c0 = ticks();
+            while(now_ns()-t0<ms*1e6);
+            double t1 = now_ns();
+            uint64_t c1 = ticks();
+            g_clock.tick_ns = (t1-t0)/(double)(c1-c0);
+        }
+        std::vector<double> e(1001);
+        for(auto& x:e){
+            uint64_t c0 = ticks();
+            uint64_t c1 = ticks();
+            x = (double)(c1-c0)*g_clock.tick_ns;
+        }
+        std::nth_element(e.begin(),e.begin()+e.size()/2,e.end());
+        g_clock.overhead_ns = e[e.size()/2];
+    }
+
+    //防止结果被优化掉
+    template<class T>
+    inline void do_not_optimize(const T& v){
+        asm volatile("" : : "g"(&v) : "memory");
+    }
+
+    // 每个元素的硬件计数，不可用的计数为nan
+    struct counters{
+        double cycles = NAN, instructions = NAN, branch_misses = NAN, l1d_misses = NAN;
+        double ipc() const { return instructions/cycles; }
+    };
+
+    // 每个事件单独打开（某个事件不支持时其他照常计数），只计用户态；被复用时按time_enabled/time_running放大
+    class perf_counters{
+    public:
+        static const int N = 4;
+        //打开失败时返回false，reason为第一个失败的原因
+        bool open(){
+            close();
+#if BENCH_HAS_PERF
+            const uint32_t type[N] = {PERF_TYPE_HARDWARE,PERF_TYPE_HARDWARE,PERF_TYPE_HARDWARE,PERF_TYPE_HW_CACHE};
+            const uint64_t config[N] = {PERF_COUNT_HW_CPU_CYCLES,PERF_COUNT_HW_INSTRUCTIONS,PERF_COUNT_HW_BRANCH_MISSES,
+                PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ<<8) | (PERF_COUNT_HW_CACHE_RESULT_MISS<<16)};
+            bool any = false;
+            for(int i=0;i<N;++i){
+                perf_event_attr a;
+                memset(&a,0,sizeof(a));
+                a.size = sizeof(a);
+                a.type = type[i];
+                a.config = config[i];
+                a.disabled = 1;
+                a.exclude_kernel = 1;
+                a.exclude_hv = 1;
+                a.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                fd[i] = (int)syscall(SYS_perf_event_open,&a,0,-1,-1,0);
+                if(fd[i]>=0) any = true;
+                else if(reason.empty()) reason = strerror(errno);
+            }
+            if(!any) close();
+            return any;
+#else
+            reason = "perf_event_open is Linux only";
+            return false;
+#endif
+        }
+        void close(){
+#if BENCH_HAS_PERF
+            for(int& f:fd){ if(f>=0) ::close(f); f = -1; }
+#endif
+        }
+        bool available() const {
+            for(int f:fd) if(f>=0) return true;
+            return false;
+        }
+        void start(){
+#if BENCH_HAS_PERF
+            for(int f:fd) if(f>=0){ ioctl(f,PERF_EVENT_IOC_RESET,0); ioctl(f,PERF_EVENT_IOC_ENABLE,0); }
+#endif
+        }
+        //停止计数，返回除以elems后的值
+        counters stop(double elems){
+            double v[N] = {NAN,NAN,NAN,NAN};
+#if BENCH_HAS_PERF
+            for(int i=0;i<N;++i){
+                if(fd[i]<0) continue;
+                ioctl(fd[i],PERF_EVENT_IOC_DISABLE,0);
+                uint64_t r[3];
+                if(read(fd[i],r,sizeof(r))==(ssize_t)sizeof(r) && r[2]>0) v[i] = (double)r[0]*((double)r[1]/r[2])/elems;
+            }
+#endif
+            counters c;
+            c.cycles = v[0];
+            c.instructions = v[1];
+            c.branch_misses = v[2];
+            c.l1d_misses = v[3];
+            return c;
+        }
+        ~perf_counters(){ close(); }
+        std::string reason;
+    private:
+        int fd[N] = {-1,-1,-1,-1};
+    };
+
+    // 中位数与其95%置信区间：样本排序后取第n/2±0.98*sqrt(n)个（二项分布的正态近似，不假设时间的分布）
+    struct stats{
+        double median = 0, lo = 0, hi = 0, min = 0;
+        size_t n = 0;
+        counters pmu; //所有样本的平均，见perf_counters
+    };
+    inline stats summarize(std::vector<double> t){
+        stats s;
+        s.n = t.size();
+        if(t.empty()) return s;
+        std::sort(t.begin(),t.end());
+        size_t n = t.size();
+        s.median = n%2 ? t[n/2] : (t[n/2-1]+t[n/2])/2;
+        double k = 0.98*std::sqrt((double)n);
+        s.lo = t[(size_t)std::max(0.0,std::floor(n/2.0-k))];
+        s.hi = t[(size_t)std::min((double)n-1,std::ceil(n/2.0+k))];
+        s.min = t[0];
+        return s;
+    }
+    inline stats shift(stats s,double d){
+        s.median = std::max(0.0,s.median-d);
+        s.lo = std::max(0.0,s.lo-d);
+        s.hi = std::max(0.0,s.hi-d);
+        s.min = std::max(0.0,s.min-d);
+        return s;
+    }
+
+    struct options{
+        int samples = 31;
+        double warmup_ms = 5;
+        double sample_us = 200;
+        perf_counters* perf = nullptr; //非空且可用时同时计数
+        size_t pressure_kb = 0; //非0时为缓存压力模式
+        size_t batch = 64; //缓存压力模式下每批的元素个数
+        int batches = 4; //缓存压力模式下每个样本的批数
+    };
+
+    //读写一遍kb大小的缓冲区（每个缓存行一次）
+    inline void pollute(size_t kb){
+        static std::vector<uint8_t> buf;
+        if(buf.size()<kb*1024) buf.resize(kb*1024);
+        for(size_t i=0;i<kb*1024;i+=64) buf[i] += 1;
+        do_not_optimize(buf[0]);
+    }
+
+    // 缓存压力模式：每批之前pollute，逐批计时；批的起点在[0,elems)中轮换，输入也不在缓存中
+    template<class F>
+    inline stats measure_pressure(F&& run,size_t elems,const options& opt){
+        const size_t batch = std::min(opt.batch,elems);
+        const size_t nb = elems/batch;
+        for(size_t b=0;b<nb;++b) run(b*batch,(b+1)*batch);
+        std::vector<double> t;
+        bool pmu = opt.perf && opt.perf->available();
+        counters sum;
+        sum.cycles = sum.instructions = sum.branch_misses = sum.l1d_misses = 0;
+        size_t k = 0;
+        for(int s=0;s<opt.samples;++s){
+            double ns = 0;
+            for(int r=0;r<opt.batches;++r,++k){
+                size_t b = (k*7919)%nb*batch;
+                pollute(opt.pressure_kb);
+                if(pmu) opt.perf->start();
+                uint64_t c0 = ticks();
+                run(b,b+batch);
+                uint64_t c1 = ticks();
+                if(pmu){
+                    counters c = opt.perf->stop((double)opt.batches*opt.samples*batch);
+                    sum.cycles += c.cycles; sum.instructions += c.instructions;
+                    sum.branch_misses += c.branch_misses; sum.l1d_misses += c.l1d_misses;
+                }
+                ns += std::max(0.0,(double)(c1-c0)*g_clock.tick_ns-g_clock.overhead_ns);
+            }
+            t.push_back(ns/((double)opt.batches*batch));
+        }
+        stats s = summarize(t);
+        if(pmu) s.pmu = sum;
+        return s;
+    }
+
+    // 计时run(b,e)：run计算第[b,e)个元素，返回每元素纳秒数的统计
+    // 先预热至少warmup_ms，同时估计一遍elems个元素的用时，确定每个样本的遍数；缓存压力模式见measure_pressure
+    template<class F>
+    inline stats measure(F&& run,size_t elems,const options& opt){
+        if(opt.pressure_kb) return measure_pressure(run,elems,opt);
+        double st = now_ns();
+        size_t calls = 0;
+        do{ run(0,elems); ++calls; }while(now_ns()-st<opt.warmup_ms*1e6 || calls<2);
+        double per_call = (now_ns()-st)/calls;
+        size_t reps = std::max<size_t>(1,(size_t)(opt.sample_us*1e3/std::max(per_call,1.0)));
+        std::vector<double> t;
+        bool pmu = opt.perf && opt.perf->available();
+        if(pmu) opt.perf->start();
+        for(int s=0;s<opt.samples;++s){
+            uint64_t c0 = ticks();
+            for(size_t r=0;r<reps;++r) run(0,elems);
+            uint64_t c1 = ticks();
+            t.push_back((double)(c1-c0)*g_clock.tick_ns/((double)reps*elems));
+        }
+        counters c;
+        if(pmu) c = opt.perf->stop((double)opt.samples*reps*elems);
+        stats s = summarize(t);
+        s.pmu = c;
+        return s;
+    }
+
+    struct result{
+        std::string func, type, tier, mode;
+        std::string input = "synthetic"; //trace为FM_CAPTURE记录的参数（--replay）
+        size_t pressure_kb = 0;
+        stats ns;
+        double vs_std = 0; //std档位用时/本档位用时，0为无对应的std结果
+    };
+
+    //nan的计数在csv中为空，在json中为null
+    inline std::string fmt_count(double v,const char* nan_str){
+        if(std::isnan(v)) return nan_str;
+        char b[32];
+        snprintf(b,sizeof(b),"%.4f",v);
+        return b;
+    }
+
+    inline void write_csv(FILE* f,const std::vector<result>& rs){
+        fprintf(f,"func,type,tier,mode,input,pressure_kb,median_ns,ci_lo_ns,ci_hi_ns,min_ns,samples,vs_std,cycles,instructions,ipc,branch_misses,l1d_misses\n");
+        for(auto& r:rs){
+            const counters& c = r.ns.pmu;
+            fprintf(f,"%s,%s,%s,%s,%s,%zu,%.4f,%.4f,%.4f,%.4f,%zu,%.3f,%s,%s,%s,%s,%s\n",r.func.c_str(),r.type.c_str(),r.tier.c_str(),r.mode.c_str(),
+                r.input.c_str(),r.pressure_kb,r.ns.median,r.ns.lo,r.ns.hi,r.ns.min,r.ns.n,r.vs_std,fmt_count(c.cycles,"").c_str(),fmt_count(c.instructions,"").c_str(),
+                fmt_count(c.ipc(),"").c_str(),fmt_count(c.branch_misses,"").c_str(),fmt_count(c.l1d_misses,"").c_str());
+        }
+    }
+
+    // meta为已格式化好的JSON键值对（不含外层花括号）
+    inline void write_json(FILE* f,const std::string& meta,const std::vector<result>& rs){
+        fprintf(f,"{\n  %s,\n  \"results\": [\n",meta.c_str());
+        for(size_t i=0;i<rs.size();++i){
+            const result& r = rs[i];
+            const counters& c = r.ns.pmu;
+            fprintf(f,"    {\"func\": \"%s\", \"type\": \"%s\", \"tier\": \"%s\", \"mode\": \"%s\", \"input\": \"%s\", \"pressure_kb\": %zu, \"median_ns\": %.4f, \"ci_lo_ns\": %.4f, \"ci_hi_ns\": %.4f, \"min_ns\": %.4f, \"samples\": %zu, \"vs_std\": %.3f, "
+                "\"cycles\": %s, \"instructions\": %s, \"ipc\": %s, \"branch_misses\": %s, \"l1d_misses\": %s}%s\n",
+                r.func.c_str(),r.type.c_str(),r.tier.c_str(),r.mode.c_str(),r.input.c_str(),r.pressure_kb,r.ns.median,r.ns.lo,r.ns.hi,r.ns.min,r.ns.n,r.vs_std,
+                fmt_count(c.cycles,"null").c_str(),fmt_count(c.instructions,"null").c_str(),fmt_count(c.ipc(),"null").c_str(),
+                fmt_count(c.branch_misses,"null").c_str(),fmt_count(c.l1d_misses,"null").c_str(),i+1<rs.size()?",":"");
+        }
+        fprintf(f,"  ]\n}\n");
+    }
+
+}
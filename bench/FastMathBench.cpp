@@ -0,0 +1,411 @@
+// FastMath.h所有函数所有档位的基准测试（计时、统计与输出见BenchHarness.h），以及按fm档位选择实现的vecmat::vec::normalized
+// 每个函数：float标量、double标量、批量接口，各档位分别计时
+//   throughput：对4096个输入逐个计算（互相独立，可流水、可被编译器向量化）
+//   latency：每次的输入依赖上一次的结果（x[i+1] = in[i+1] + y[i]*0），减去同样依赖链下恒等函数的用时；批量接口只测throughput
+// 输入分布按函数选取（见register_cases），固定种子，不同构建之间可直接比较
+// --perf：同时读取硬件计数器（每元素cycles、instructions、IPC、branch misses、L1D misses，见BenchHarness.h），
+//   不可用时打印原因，只输出用时；latency的计数包含依赖链本身的开销
+// -w 16,256,4096,65536：另对每个throughput的用例在这些工作集大小（KB）下测缓存压力模式（mode为pressure，见BenchHarness.h），
+//   每批-b个元素（默认64）之前读写一遍该大小的缓冲区，查看查表法的档位在表不在缓存中时是否仍快于多项式法或std
+// --replay DIR：不使用上述分布，改用FM_CAPTURE=1记录的实际参数（DIR/<函数名>.f32.fmcap、.f64.fmcap，见FastMathCapture.inl.h），
+//   对有记录的函数的所有档位计时（input为trace）；记录多于-n个时等间隔取-n个（向下取2的幂）
+// 用法：FastMathBench [-o out.json] [-c out.csv] [-m throughput|latency] [-r 样本数] [-n 元素个数] [-T std,normal,...] [-w KB,...] [-b 批大小] [--replay DIR] [--chrono] [--perf] [函数名...]
+#include "FastMath.h"
+#include "VecMat.h"
+#include "BenchHarness.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+static const char* tier_names[5] = {"std","normal","fast1","fast2","fast3"};
+static size_t g_n = 4096;
+
+// 输入分布：[lo,hi]上均匀，或log为true时对数均匀（lo>0）
+struct dist{
+    double lo, hi;
+    bool log = false;
+};
+static dist uni(double lo,double hi){ return {lo,hi,false}; }
+static dist logu(double lo,double hi){ return {lo,hi,true}; }
+
+template<class T>
+static std::vector<T> gen(const dist& d,unsigned seed){
+    std::mt19937 e(seed);
+    std::uniform_real_distribution<double> u(0,1);
+    std::vector<T> v(g_n);
+    for(auto& x:v) x = (T)(d.log ? d.lo*std::pow(d.hi/d.lo,u(e)) : d.lo+(d.hi-d.lo)*u(e));
+    return v;
+}
+
+// FM_CAPTURE记录的参数（文件格式见FastMathCapture.inl.h），values按记录依次存放，每条arity个
+struct trace{
+    uint32_t arity = 0;
+    std::vector<double> values;
+    size_t records() const { return arity ? values.size()/arity : 0; }
+};
+
+static bool load_trace(const std::string& path,trace& t){
+    std::ifstream f(path,std::ios::binary);
+    char magic[8];
+    uint32_t size = 0;
+    if(!f.read(magic,8) || memcmp(magic,"FMCAP1\0\0",8)!=0) return false;
+    if(!f.read((char*)&t.arity,4) || !f.read((char*)&size,4) || (t.arity!=1 && t.arity!=2) || (size!=4 && size!=8)) return false;
+    std::vector<char> raw((std::istreambuf_iterator<char>(f)),std::istreambuf_iterator<char>());
+    t.values.resize(raw.size()/size);
+    for(size_t i=0;i<t.values.size();++i){
+        if(size==4){ float v; memcpy(&v,&raw[i*4],4); t.values[i] = v; }
+        else memcpy(&t.values[i],&raw[i*8],8);
+    }
+    return t.records()>0;
+}
+
+// 第col个参数：有记录时从记录中等间隔取（个数为不超过g_n的2的幂），否则按分布d生成
+template<class T>
+static std::vector<T> inputs(const dist& d,const trace* tr,uint32_t col){
+    if(!tr) return gen<T>(d,col+1);
+    size_t n = 1;
+    while(n*2<=std::min(g_n,tr->records())) n *= 2;
+    std::vector<T> v(n);
+    for(size_t i=0;i<n;++i) v[i] = (T)tr->values[(i*tr->records()/n)*tr->arity+col];
+    return v;
+}
+
+struct bench_case{
+    std::string func, type;
+    int tier;
+    bool latency;
+    uint32_t arity;
+    std::function<bench::stats(const bench::options&,const trace*)> run;
+};
+static std::vector<bench_case> cases;
+static double g_latency_overhead[2]; //float double
+
+template<class T>
+static const char* type_name(){ return sizeof(T)==4 ? "float" : "double"; }
+
+// 依赖链：y*0不能被编译器消去（y可能为inf/nan），因此下一次的输入依赖这一次的结果
+template<class T,class F>
+static bench::stats measure_chain(F f,const std::vector<T>& in,const bench::options& o){
+    const size_t mask = in.size()-1;
+    return bench::measure([&](size_t b,size_t e){
+        T x = in[b];
+        for(size_t i=b;i<e;++i) x = in[(i+1)&mask] + f(x)*(T)0;
+        bench::do_not_optimize(x);
+    },in.size(),o);
+}
+
+template<class T,int S,class F>
+static void add_unary_tier(const char* name,F f,dist d){
+    cases.push_back({name,type_name<T>(),S,false,1,[=](const bench::options& o,const trace* tr){
+        std::vector<T> in = inputs<T>(d,tr,0), out(in.size());
+        return bench::measure([&](size_t b,size_t e){
+            for(size_t i=b;i<e;++i) out[i] = f(in[i],(fm::speed_option)S);
+            bench::do_not_optimize(out[0]);
+        },in.size(),o);
+    }});
+    cases.push_back({name,type_name<T>(),S,true,1,[=](const bench::options& o,const trace* tr){
+        std::vector<T> in = inputs<T>(d,tr,0);
+        return measure_chain<T>([&](T x){ return f(x,(fm::speed_option)S); },in,o);
+    }});
+}
+template<class T,class F>
+static void add_unary(const char* name,F f,dist d){
+    add_unary_tier<T,0>(name,f,d);
+    add_unary_tier<T,1>(name,f,d);
+    add_unary_tier<T,2>(name,f,d);
+    add_unary_tier<T,3>(name,f,d);
+    add_unary_tier<T,4>(name,f,d);
+}
+
+// 双参数函数，依赖链经过第一个参数
+template<class T,int S,class F>
+static void add_binary_tier(const char* name,F f,dist dx,dist dy){
+    cases.push_back({name,type_name<T>(),S,false,2,[=](const bench::options& o,const trace* tr){
+        std::vector<T> x = inputs<T>(dx,tr,0), y = inputs<T>(dy,tr,1), out(x.size());
+        return bench::measure([&](size_t b,size_t e){
+            for(size_t i=b;i<e;++i) out[i] = f(x[i],y[i],(fm::speed_option)S);
+            bench::do_not_optimize(out[0]);
+        },x.size(),o);
+    }});
+    cases.push_back({name,type_name<T>(),S,true,2,[=](const bench::options& o,const trace* tr){
+        std::vector<T> x = inputs<T>(dx,tr,0), y = inputs<T>(dy,tr,1);
+        size_t i = 0;
+        return measure_chain<T>([&](T a){ T r = f(a,y[i],(fm::speed_option)S); i = (i+1)&(y.size()-1); return r; },x,o);
+    }});
+}
+template<class T,class F>
+static void add_binary(const char* name,F f,dist dx,dist dy){
+    add_binary_tier<T,0>(name,f,dx,dy);
+    add_binary_tier<T,1>(name,f,dx,dy);
+    add_binary_tier<T,2>(name,f,dx,dy);
+    add_binary_tier<T,3>(name,f,dx,dy);
+    add_binary_tier<T,4>(name,f,dx,dy);
+}
+
+// 批量接口：f(in,in2,out,out2,n,speed)，单输入单输出的函数（arity为1）忽略in2、out2
+template<class T,class F>
+static void add_batch(const char* name,F f,dist d,uint32_t arity=1,dist d2=uni(0,1)){
+    for(int s=0;s<5;++s){
+        cases.push_back({name,sizeof(T)==4?"batch_float":"batch_double",s,false,arity,[=](const bench::options& o,const trace* tr){
+            std::vector<T> in = inputs<T>(d,tr,0), in2 = arity==2 ? inputs<T>(d2,tr,1) : std::vector<T>(in.size()), out(in.size()), out2(in.size());
+            return bench::measure([&](size_t b,size_t e){
+                f(in.data()+b,in2.data()+b,out.data()+b,out2.data()+b,e-b,(fm::speed_option)s);
+                bench::do_not_optimize(out[0]);
+            },in.size(),o);
+        }});
+    }
+}
+
+// vec<N,T>::normalized，分量为x,x+1,...，返回各分量之和
+template<uint32_t N,class T>
+static T bench_normalized(T x,fm::speed_option s){
+    vecmat::vec<N,T> v;
+    for(uint32_t j=0;j<N;++j) v[j] = x+(T)j;
+    v = v.normalized(s);
+    T r = 0;
+    for(uint32_t j=0;j<N;++j) r += v[j];
+    return r;
+}
+
+#define FM_UNARY(func) [](auto x,fm::speed_option s){ return fm::func(x,s); }
+#define FM_BINARY(func) [](auto x,auto y,fm::speed_option s){ return fm::func(x,y,s); }
+#define FM_BATCH(func) [](const auto* in,const auto*,auto* out,auto*,size_t n,fm::speed_option s){ fm::func(in,out,n,s); }
+#define FM_BATCH2(func) [](const auto* x,const auto* y,auto* out,auto*,size_t n,fm::speed_option s){ fm::func(x,y,out,n,s); }
+
+//float与double标量版本使用同一输入分布
+#define ADD_UNARY(func,d) add_unary<float>(#func,FM_UNARY(func),d); add_unary<double>(#func,FM_UNARY(func),d)
+#define ADD_BINARY(func,dx,dy) add_binary<float>(#func,FM_BINARY(func),dx,dy); add_binary<double>(#func,FM_BINARY(func),dx,dy)
+
+static void register_cases(){
+    const dist angle = uni(-10,10), unit = uni(-1,1), pos = logu(1e-10,1e10);
+    ADD_UNARY(sin,angle);
+    ADD_UNARY(cos,angle);
+    ADD_UNARY(tan,angle);
+    add_unary<float>("sincos",[](float x,fm::speed_option s){ float a,b; fm::sincos(x,&a,&b,s); return a+b; },angle);
+    add_unary<double>("sincos",[](double x,fm::speed_option s){ double a,b; fm::sincos(x,&a,&b,s); return a+b; },angle);
+    ADD_UNARY(asin,unit);
+    ADD_UNARY(acos,unit);
+    ADD_UNARY(atan,uni(-10,10));
+    ADD_UNARY(exp,uni(-20,20));
+    ADD_UNARY(exp2,uni(-30,30));
+    ADD_UNARY(expm1,uni(-5,5));
+    ADD_UNARY(log,pos);
+    ADD_UNARY(log2,pos);
+    ADD_UNARY(log10,pos);
+    ADD_UNARY(log1p,uni(-0.9,10));
+    ADD_UNARY(cbrt,uni(-1e6,1e6));
+    ADD_UNARY(rsqrt,logu(1e-6,1e6));
+    ADD_UNARY(tanh,uni(-5,5));
+    ADD_UNARY(sinh,uni(-10,10));
+    ADD_UNARY(cosh,uni(-10,10));
+    ADD_UNARY(erf,uni(-4,4));
+    ADD_UNARY(sigmoid,uni(-20,20));
+    ADD_UNARY(softplus,uni(-20,20));
+    ADD_BINARY(pow,logu(1e-3,1e3),uni(-4,4));
+    ADD_BINARY(atan2,uni(-10,10),uni(-10,10));
+    ADD_BINARY(hypot,uni(-1e3,1e3),uni(-1e3,1e3));
+    //名称中不含逗号，便于csv
+    add_unary<float>("pown5",[](float x,fm::speed_option s){ return fm::pown<5>(x,s); },uni(0,2));
+    add_unary<float>("pown11_5",[](float x,fm::speed_option s){ return fm::pown<11,5>(x,s); },uni(0,1));
+    add_unary<float>("pown5_12",[](float x,fm::speed_option s){ return fm::pown<5,12>(x,s); },uni(0,1));
+    add_unary<float>("normalized2",bench_normalized<2,float>,uni(-10,10));
+    add_unary<float>("normalized3",bench_normalized<3,float>,uni(-10,10));
+    add_unary<float>("normalized4",bench_normalized<4,float>,uni(-10,10));
+    add_unary<double>("normalized2",bench_normalized<2,double>,uni(-10,10));
+    add_unary<double>("normalized3",bench_normalized<3,double>,uni(-10,10));
+    add_unary<double>("normalized4",bench_normalized<4,double>,uni(-10,10));
+
+    add_batch<float>("sin",FM_BATCH(sin),angle);
+    add_batch<float>("cos",FM_BATCH(cos),angle);
+    add_batch<float>("tan",FM_BATCH(tan),angle);
+    add_batch<float>("sincos",[](const float* in,const float*,float* s,float* c,size_t n,fm::speed_option sp){ fm::sincos(in,s,c,n,sp); },angle);
+    add_batch<float>("atan",FM_BATCH(atan),uni(-10,10));
+    add_batch<double>("atan",FM_BATCH(atan),uni(-10,10));
+    add_batch<float>("exp",FM_BATCH(exp),uni(-20,20));
+    add_batch<float>("expm1",FM_BATCH(expm1),uni(-5,5));
+    add_batch<float>("log10",FM_BATCH(log10),pos);
+    add_batch<float>("log1p",FM_BATCH(log1p),uni(-0.9,10));
+    add_batch<float>("cbrt",FM_BATCH(cbrt),uni(-1e6,1e6));
+    add_batch<float>("rsqrt",FM_BATCH(rsqrt),logu(1e-6,1e6));
+    add_batch<float>("tanh",FM_BATCH(tanh),uni(-5,5));
+    add_batch<float>("sinh",FM_BATCH(sinh),uni(-10,10));
+    add_batch<float>("cosh",FM_BATCH(cosh),uni(-10,10));
+    add_batch<float>("erf",FM_BATCH(erf),uni(-4,4));
+    add_batch<float>("sigmoid",FM_BATCH(sigmoid),uni(-20,20));
+    add_batch<float>("softplus",FM_BATCH(softplus),uni(-20,20));
+    add_batch<float>("pow",FM_BATCH2(pow),logu(1e-3,1e3),2,uni(-4,4));
+    add_batch<float>("atan2",FM_BATCH2(atan2),uni(-10,10),2,uni(-10,10));
+    add_batch<double>("atan2",FM_BATCH2(atan2),uni(-10,10),2,uni(-10,10));
+    add_batch<float>("hypot",FM_BATCH2(hypot),uni(-1e3,1e3),2,uni(-1e3,1e3));
+    add_batch<float>("pown5",[](const float* in,const float*,float* out,float*,size_t n,fm::speed_option s){ fm::pown<5>(in,out,n,s); },uni(0,2));
+    add_batch<float>("pown11_5",[](const float* in,const float*,float* out,float*,size_t n,fm::speed_option s){ fm::pown<11,5>(in,out,n,s); },uni(0,1));
+}
+
+struct cli{
+    const char* json = nullptr;
+    const char* csv = nullptr;
+    bool throughput = true, latency = true, tsc = true, perf = false;
+    bool tiers[5] = {true,true,true,true,true};
+    std::vector<std::string> names;
+    std::vector<size_t> pressure_kb;
+    const char* replay = nullptr;
+    bench::options opt;
+};
+
+static bool parse_args(int argc,char** argv,cli& c){
+    for(int i=1;i<argc;++i){
+        std::string a = argv[i];
+        if((a=="-o"||a=="-c"||a=="-m"||a=="-r"||a=="-n"||a=="-T"||a=="-w"||a=="-b"||a=="--replay") && i+1>=argc) return false;
+        if(a=="-o") c.json = argv[++i];
+        else if(a=="-c") c.csv = argv[++i];
+        else if(a=="-m"){
+            std::string m = argv[++i];
+            c.throughput = m=="throughput";
+            c.latency = m=="latency";
+            if(!c.throughput && !c.latency) return false;
+        }
+        else if(a=="-r") c.opt.samples = std::max(3,atoi(argv[++i]));
+        else if(a=="-n"){
+            //依赖链的下标用&(n-1)回绕，n取2的幂
+            size_t n = (size_t)std::max(16ll,atoll(argv[++i]));
+            g_n = 1;
+            while(g_n*2<=n) g_n *= 2;
+        }
+        else if(a=="-T"){
+            std::string list = std::string(",")+argv[++i]+",";
+            for(int k=0;k<5;++k) c.tiers[k] = list.find(std::string(",")+tier_names[k]+",")!=std::string::npos;
+        }
+        else if(a=="-w"){
+            for(const char* p=argv[++i];*p;){
+                char* end;
+                long kb = strtol(p,&end,10);
+                if(end==p || kb<=0) return false;
+                c.pressure_kb.push_back((size_t)kb);
+                p = *end==',' ? end+1 : end;
+            }
+        }
+        else if(a=="-b") c.opt.batch = (size_t)std::max(1,atoi(argv[++i]));
+        else if(a=="--replay") c.replay = argv[++i];
+        else if(a=="--chrono") c.tsc = false;
+        else if(a=="--perf") c.perf = true;
+        else if(a[0]=='-') return false;
+        else c.names.push_back(a);
+    }
+    return true;
+}
+
+int main(int argc,char** argv){
+    cli c;
+    if(!parse_args(argc,argv,c)){
+        fprintf(stderr,"usage: %s [-o out.json] [-c out.csv] [-m throughput|latency] [-r samples] [-n elements] [-T std,normal,fast1,fast2,fast3] [-w KB,...] [-b batch] [--replay dir] [--chrono] [--perf] [func...]\n",argv[0]);
+        return 2;
+    }
+    bench::calibrate_clock(c.tsc);
+    register_cases();
+
+    //--replay：每个函数的.f32/.f64记录，没有记录的函数不计时
+    std::map<std::string,trace> traces;
+    if(c.replay){
+        for(auto& bc:cases){
+            for(const char* ext:{".f32",".f64"}){
+                std::string key = bc.func+ext;
+                trace t;
+                if(!traces.count(key) && load_trace(std::string(c.replay)+"/"+key+".fmcap",t)){
+                    printf("replay %s: %zu records\n",key.c_str(),t.records());
+                    traces[key] = std::move(t);
+                }
+            }
+        }
+        if(traces.empty()){ fprintf(stderr,"no .fmcap files in %s\n",c.replay); return 2; }
+    }
+
+    {
+        bench::options o = c.opt;
+        std::vector<float> f = gen<float>(uni(-1,1),1);
+        std::vector<double> d = gen<double>(uni(-1,1),1);
+        g_latency_overhead[0] = measure_chain<float>([](float x){ return x; },f,o).median;
+        g_latency_overhead[1] = measure_chain<double>([](double x){ return x; },d,o).median;
+    }
+    printf("clock %s (%.4f ns/tick), simd %s, FM_TRIG_POLY=%d, %zu elements, %d samples, latency overhead %.3f/%.3f ns (float/double)\n",
+        bench::g_clock.name(),bench::g_clock.tick_ns,simd_dispatch::level_name(fm::get_simd_level()),FM_TRIG_POLY,g_n,c.opt.samples,
+        g_latency_overhead[0],g_latency_overhead[1]);
+    bench::perf_counters perf;
+    std::string perf_status = "off";
+    if(c.perf){
+        if(perf.open()){
+            c.opt.perf = &perf;
+            perf_status = "on";
+        }
+        else perf_status = "unavailable: "+perf.reason;
+        printf("perf counters %s\n",perf_status.c_str());
+    }
+    const bool pmu = c.opt.perf!=nullptr;
+    printf("%-10s %-12s %-6s %-16s %10s %21s %8s","func","type","tier","mode","median_ns","95% ci","vs_std");
+    if(pmu) printf(" %9s %9s %6s %9s %9s","cycles","instr","ipc","br_miss","l1d_miss");
+    printf("\n");
+
+    std::vector<bench::result> rs;
+    auto run_case = [&](const bench_case& bc,const trace* tr,size_t kb){
+        bench::options o = c.opt;
+        o.pressure_kb = kb;
+        bench::result r;
+        r.func = bc.func;
+        r.type = bc.type;
+        r.tier = tier_names[bc.tier];
+        r.mode = kb ? "pressure" : (bc.latency ? "latency" : "throughput");
+        r.input = tr ? "trace" : "synthetic";
+        r.pressure_kb = kb;
+        r.ns = bc.run(o,tr);
+        if(bc.latency) r.ns = bench::shift(r.ns,g_latency_overhead[bc.type=="double"]);
+        //std档位总在同一函数其他档位之前注册
+        if(bc.tier==fm::ESpeedStd) r.vs_std = 1;
+        for(auto& p:rs){
+            if(p.func==r.func && p.type==r.type && p.mode==r.mode && p.input==r.input && p.pressure_kb==r.pressure_kb && p.tier=="std" && r.ns.median>0) r.vs_std = p.ns.median/r.ns.median;
+        }
+        std::string mode = kb ? r.mode+":"+std::to_string(kb)+"K" : r.mode;
+        printf("%-10s %-12s %-6s %-16s %10.3f   [%8.3f,%8.3f] %8.2f",r.func.c_str(),r.type.c_str(),r.tier.c_str(),mode.c_str(),
+            r.ns.median,r.ns.lo,r.ns.hi,r.vs_std);
+        const bench::counters& pc = r.ns.pmu;
+        if(pmu) printf(" %9.2f %9.2f %6.2f %9.4f %9.4f",pc.cycles,pc.instructions,pc.ipc(),pc.branch_misses,pc.l1d_misses);
+        printf("\n");
+        fflush(stdout);
+        rs.push_back(r);
+    };
+    for(auto& bc:cases){
+        if(!c.tiers[bc.tier]) continue;
+        if(!c.names.empty() && std::find(c.names.begin(),c.names.end(),bc.func)==c.names.end()) continue;
+        const trace* tr = nullptr;
+        if(c.replay){
+            bool f32 = bc.type=="float" || bc.type=="batch_float";
+            auto it = traces.find(bc.func+(f32 ? ".f32" : ".f64"));
+            if(it==traces.end() || it->second.arity!=bc.arity) continue;
+            tr = &it->second;
+        }
+        if(bc.latency ? c.latency : c.throughput) run_case(bc,tr,0);
+        if(!bc.latency) for(size_t kb:c.pressure_kb) run_case(bc,tr,kb);
+    }
+
+    if(c.csv){
+        FILE* f = fopen(c.csv,"w");
+        if(!f){ fprintf(stderr,"cannot open %s\n",c.csv); return 2; }
+        bench::write_csv(f,rs);
+        fclose(f);
+    }
+    if(c.json){
+        FILE* f = fopen(c.json,"w");
+        if(!f){ fprintf(stderr,"cannot open %s\n",c.json); return 2; }
+        char meta[1536];
+        snprintf(meta,sizeof(meta),"\"clock\": \"%s\", \"tick_ns\": %.6f, \"simd\": \"%s\", \"fm_trig_poly\": %d, \"elements\": %zu, \"samples\": %d, \"latency_overhead_ns\": [%.4f, %.4f], \"perf\": \"%s\", \"replay\": \"%s\", \"compiler\": \"%s\"",
+            bench::g_clock.name(),bench::g_clock.tick_ns,simd_dispatch::level_name(fm::get_simd_level()),FM_TRIG_POLY,g_n,c.opt.samples,
+            g_latency_overhead[0],g_latency_overhead[1],perf_status.c_str(),c.replay ? c.replay : "",__VERSION__);
+        bench::write_json(f,meta,rs);
+        fclose(f);
+    }
+    return 0;
+}
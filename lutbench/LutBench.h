@@ -0,0 +1,17 @@
+// 多编译单元共用查表的测试：每个模块由CMake从LutBenchModule.cpp.in生成，模拟大型项目中
+// 各自#include "FastMath.h"并在同一热循环中调用fm::sin的编译单元
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+struct LutBenchModule{
+    float (*shared)(const float* in,size_t n);  //fm::sin（所有编译单元共用一份表）
+    float (*priv)(const float* in,size_t n);    //同样的查表，但使用本编译单元私有的表（旧做法）
+    const void* shared_table;
+    const void* private_table;
+};
+
+//各模块在静态初始化时注册
+std::vector<LutBenchModule>& lut_bench_modules();
+bool lut_bench_register(const LutBenchModule& m);
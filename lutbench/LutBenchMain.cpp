@@ -0,0 +1,68 @@
+// 测试多个编译单元在同一热循环中调用fm::sin时查表的缓存行为：
+// 共用一份表时所有模块只占用一份表的缓存行，每个编译单元一份表时表的总大小随模块数增长，超出L1后查表开始缺失
+
+#include "FastMath.h"
+#include "LutBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <set>
+
+std::vector<LutBenchModule>& lut_bench_modules(){
+    static std::vector<LutBenchModule> modules;
+    return modules;
+}
+
+bool lut_bench_register(const LutBenchModule& m){
+    lut_bench_modules().push_back(m);
+    return true;
+}
+
+//每轮把数据分为小块，每一块依次交给所有模块处理（即所有模块在同一热循环中查表），取多轮的中位数
+template <typename F>
+double lut_bench_time(const std::vector<float>& in,size_t chunk,int rounds,F f,float* sink){
+    std::vector<double> t;
+    for(int r=0;r<rounds;++r){
+        auto st = std::chrono::steady_clock::now();
+        float acc=0;
+        for(size_t i=0;i+chunk<=in.size();i+=chunk){
+            for(const LutBenchModule& m:lut_bench_modules()) acc+=f(m)(in.data()+i,chunk);
+        }
+        t.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now()-st).count());
+        *sink+=acc;
+    }
+    std::sort(t.begin(),t.end());
+    return t[t.size()/2];
+}
+
+int main(){
+    const std::vector<LutBenchModule>& modules = lut_bench_modules();
+    std::set<const void*> shared_tables,private_tables;
+    for(const LutBenchModule& m:modules){
+        shared_tables.insert(m.shared_table);
+        private_tables.insert(m.private_table);
+    }
+    const size_t table_bytes = sizeof(fm::_lut_table<fm::_bk>);
+    printf("modules: %zu\n",modules.size());
+    printf("shared  : %zu distinct table(s), %zu bytes, 64B aligned: %s\n",shared_tables.size(),shared_tables.size()*table_bytes,
+        ((size_t)*shared_tables.begin()%64==0)?"yes":"no");
+    printf("private : %zu distinct table(s), %zu bytes\n",private_tables.size(),private_tables.size()*table_bytes);
+
+    std::mt19937 e(1);
+    std::uniform_real_distribution<float> u(-100.0f,100.0f);
+    std::vector<float> in(1<<16);
+    for(float& x:in) x=u(e);
+
+    float sink=0;
+    printf("%8s %14s %14s %8s\n","chunk","shared(ns/op)","private(ns/op)","ratio");
+    for(size_t chunk:{16,64,256}){
+        double ops = (double)(in.size()/chunk*chunk)*modules.size();
+        double ts = lut_bench_time(in,chunk,31,[](const LutBenchModule& m){return m.shared;},&sink);
+        double tp = lut_bench_time(in,chunk,31,[](const LutBenchModule& m){return m.priv;},&sink);
+        printf("%8zu %14.3f %14.3f %8.2f\n",chunk,ts/ops*1e9,tp/ops*1e9,tp/ts);
+    }
+    printf("(sink %g)\n",sink);
+    return 0;
+}
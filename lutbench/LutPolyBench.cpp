@@ -0,0 +1,112 @@
+// 查表法与多项式法（FM_TRIG_POLY=1，见sin_poly）的比较：sin cos tan sincos的批量接口，本机支持的每个SIMD版本，
+// 查表法（各档位相同）与多项式法fast1/fast2/fast3（7/5/3次），分别在表位于L1中（hot）与不在缓存中（cold）时计时
+// hot：同一块输入（4096个）反复计算，表一直在L1中
+// cold：每次计算前顺序读一遍比L2更大的缓冲区，把表挤出缓存，只计时计算本身（每次64个，模拟偶尔调用）
+// asin/acos的fast档位已是多项式法（见_acos_abs_kernel），另与asin_lut<_bk>比较标量版本
+
+#include "FastMath.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+typedef std::function<void(const float* in,float* out,float* out2,size_t n)> bench_kernel;
+
+static volatile float sink;
+
+static double now(){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//取多轮的中位数，ns/op
+static double bench_hot(const bench_kernel& f,const std::vector<float>& in,std::vector<float>& out,std::vector<float>& out2){
+    const int reps=64;
+    std::vector<double> t;
+    f(in.data(),out.data(),out2.data(),in.size());
+    for(int r=0;r<31;++r){
+        double st = now();
+        for(int k=0;k<reps;++k) f(in.data(),out.data(),out2.data(),in.size());
+        t.push_back((now()-st)/((double)reps*in.size()));
+        sink = sink+out[r];
+    }
+    std::sort(t.begin(),t.end());
+    return t[t.size()/2]*1e9;
+}
+
+//每次计算前读一遍evict，逐次计时后减去空计时的开销，取中位数，ns/op
+static double bench_cold(const bench_kernel& f,const std::vector<float>& in,std::vector<float>& out,std::vector<float>& out2,
+                         const std::vector<float>& evict,size_t chunk){
+    std::vector<double> t,empty;
+    for(int r=0;r<301;++r){
+        float acc=0;
+        for(size_t i=0;i<evict.size();i+=16) acc+=evict[i];
+        sink = sink+acc;
+        const float* p = in.data()+(r*chunk)%(in.size()-chunk);
+        double st = now();
+        f(p,out.data(),out2.data(),chunk);
+        double mid = now();
+        double ed = now();
+        t.push_back(mid-st);
+        empty.push_back(ed-mid);
+        sink = sink+out[0];
+    }
+    std::sort(t.begin(),t.end());
+    std::sort(empty.begin(),empty.end());
+    return std::max(0.0,t[t.size()/2]-empty[empty.size()/2])/chunk*1e9;
+}
+
+int main(){
+    std::mt19937 e(1);
+    std::uniform_real_distribution<float> u(-100.0f,100.0f),ua(-1.0f,1.0f);
+    std::vector<float> in(4096),ina(4096),out(4096),out2(4096);
+    for(float& x:in) x=u(e);
+    for(float& x:ina) x=ua(e);
+    std::vector<float> evict((size_t)16<<20); //64MB
+    for(size_t i=0;i<evict.size();++i) evict[i]=(float)i;
+    const size_t chunk=64;
+
+    const fm::speed_option speeds[3] = {fm::ESpeedFast1,fm::ESpeedFast2,fm::ESpeedFast3};
+    const char* funcs[4] = {"sin","cos","tan","sincos"};
+    printf("ns/op，lut为查表法（各档位相同），p7/p5/p3为多项式法fast1/fast2/fast3\n");
+    printf("%-8s %-7s | %-32s | %-32s\n","level","func","hot: lut     p7     p5     p3","cold: lut     p7     p5     p3");
+    simd_dispatch::simd_level best = simd_dispatch::detect();
+    for(int l=simd_dispatch::ESimdScalar;l<=best;++l){
+        fm::_batch_kernels k = fm::_batch_kernels_for((simd_dispatch::simd_level)l);
+        for(int fi=0;fi<4;++fi){
+            std::vector<bench_kernel> ks;
+            switch(fi){
+                case 0: ks.push_back([&](const float* a,float* b,float*,size_t n){k.sin(a,b,n,0);}); break;
+                case 1: ks.push_back([&](const float* a,float* b,float*,size_t n){k.sin(a,b,n,fm::_bk/4);}); break;
+                case 2: ks.push_back([&](const float* a,float* b,float*,size_t n){k.tan(a,b,n);}); break;
+                default: ks.push_back([&](const float* a,float* b,float* c,size_t n){k.sincos(a,b,c,n);}); break;
+            }
+            for(fm::speed_option s:speeds){
+                switch(fi){
+                    case 0: ks.push_back([&,s](const float* a,float* b,float*,size_t n){k.sin_poly(a,b,n,0.0f,s);}); break;
+                    case 1: ks.push_back([&,s](const float* a,float* b,float*,size_t n){k.sin_poly(a,b,n,0.5f,s);}); break;
+                    case 2: ks.push_back([&,s](const float* a,float* b,float*,size_t n){k.tan_poly(a,b,n,s);}); break;
+                    default: ks.push_back([&,s](const float* a,float* b,float* c,size_t n){k.sincos_poly(a,b,c,n,s);}); break;
+                }
+            }
+            printf("%-8s %-7s |",simd_dispatch::level_name(k.level),funcs[fi]);
+            for(const bench_kernel& f:ks) printf(" %6.3f",bench_hot(f,in,out,out2));
+            printf("    |");
+            for(const bench_kernel& f:ks) printf(" %6.3f",bench_cold(f,in,out,out2,evict,chunk));
+            printf("\n");
+        }
+    }
+
+    //asin：标量，asin_lut<_bk>与fm::asin的fast档位
+    std::vector<bench_kernel> ks;
+    ks.push_back([](const float* a,float* b,float*,size_t n){for(size_t i=0;i<n;++i) b[i]=fm::asin_lut<fm::_bk>(a[i]);});
+    for(fm::speed_option s:speeds) ks.push_back([s](const float* a,float* b,float*,size_t n){for(size_t i=0;i<n;++i) b[i]=fm::asin(a[i],s);});
+    printf("%-8s %-7s |","scalar","asin");
+    for(const bench_kernel& f:ks) printf(" %6.3f",bench_hot(f,ina,out,out2));
+    printf("    |");
+    for(const bench_kernel& f:ks) printf(" %6.3f",bench_cold(f,ina,out,out2,evict,chunk));
+    printf("\n");
+    return 0;
+}